@@ -1,172 +1,300 @@
 /**
  * Pathfinding Algorithms Implementation
  * Travel Route Planner - C Implementation
- * Implements: Dijkstra, A*, BFS, DFS
+ * Implements: Dijkstra, bidirectional Dijkstra, A*, BFS, DFS
+ *
+ * All searches run on the graph's CSR snapshot (see freezeGraph) using a
+ * reusable QueryContext (see query.c).
  */
 
 #include "graph.h"
+#include "query.h"
+#include "alt.h"
 
-// Priority queue node for Dijkstra and A*
-typedef struct PQNode {
-    int cityIndex;
-    int priority;
-    struct PQNode* next;
-} PQNode;
-
-// Priority queue functions
-PQNode* createPQNode(int cityIndex, int priority) {
-    PQNode* node = (PQNode*)malloc(sizeof(PQNode));
-    node->cityIndex = cityIndex;
-    node->priority = priority;
-    node->next = NULL;
-    return node;
-}
-
-void enqueuePQ(PQNode** head, int cityIndex, int priority) {
-    PQNode* newNode = createPQNode(cityIndex, priority);
-    
-    if (*head == NULL || priority < (*head)->priority) {
-        newNode->next = *head;
-        *head = newNode;
-    } else {
-        PQNode* current = *head;
-        while (current->next && current->next->priority <= priority) {
-            current = current->next;
-        }
-        newNode->next = current->next;
-        current->next = newNode;
+/**
+ * Build a PathResult from the exact CSR edges a search used, so parallel
+ * routes (e.g. Bus and Flight between the same cities) are reported correctly
+ */
+PathResult* buildPathFromEdges(const CSRGraph* csr, int start, const int* edges, int numEdges,
+                               const char* algorithm) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    if (!result) return NULL;
+    result->path = (int*)malloc((numEdges + 1) * sizeof(int));
+    result->legs = (PathLeg*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(PathLeg));
+    if (!result->path || !result->legs) {
+        destroyPathResult(result);
+        return NULL;
     }
+    strcpy(result->algorithm, algorithm);
+    result->pathLength = numEdges + 1;
+    result->totalDistance = 0;
+    result->totalTime = 0;
+    result->totalCost = 0;
+    result->path[0] = start;
+    
+    for (int i = 0; i < numEdges; i++) {
+        int e = edges[i];
+        PathLeg* leg = &result->legs[i];
+        leg->distance = csr->distance[e];
+        leg->time = csr->time[e];
+        leg->cost = csr->cost[e];
+        strcpy(leg->mode, csr->modeNames[csr->modeId[e]]);
+        
+        result->path[i + 1] = csr->target[e];
+        result->totalDistance += leg->distance;
+        result->totalTime += leg->time;
+        result->totalCost += leg->cost;
+    }
+    
+    return result;
 }
 
-int dequeuePQ(PQNode** head) {
-    if (*head == NULL) return -1;
-    
-    PQNode* temp = *head;
-    int cityIndex = temp->cityIndex;
-    *head = (*head)->next;
-    free(temp);
-    return cityIndex;
-}
-
-bool isPQEmpty(PQNode* head) {
-    return head == NULL;
+/**
+ * Build a PathResult by following the recorded parent edges back from end
+ */
+static PathResult* buildPathResult(const CSRGraph* csr, QueryContext* ctx, int end,
+                                   const char* algorithm) {
+    int numEdges = 0;
+    int start = end;
+    for (int current = end; ctx->parent[current] != -1; current = ctx->parent[current]) {
+        numEdges++;
+        start = ctx->parent[current];
+    }
+    
+    // The BFS queue / DFS stack is no longer needed, reuse it for the chain
+    int* edges = ctx->scratch;
+    int i = numEdges;
+    for (int current = end; ctx->parent[current] != -1; current = ctx->parent[current]) {
+        edges[--i] = ctx->parentEdge[current];
+    }
+    
+    return buildPathFromEdges(csr, start, edges, numEdges, algorithm);
 }
 
 /**
  * Dijkstra's Algorithm
- * Finds shortest path in weighted graph
+ * Finds shortest path in weighted graph, using only edges whose mode is in modes
  */
-PathResult* dijkstra(Graph* graph, const char* startId, const char* endId, const char* weightType) {
-    int start = findCityIndex(graph, startId);
-    int end = findCityIndex(graph, endId);
-    
-    if (start == -1 || end == -1) {
-        return NULL;
-    }
+PathResult* dijkstraQuery(Graph* graph, QueryContext* ctx, int start, int end, WeightMetric metric,
+                          ModeMask modes) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(ctx, csr->numCities)) return NULL;
     
-    int n = graph->numCities;
-    int* dist = (int*)malloc(n * sizeof(int));
-    int* parent = (int*)malloc(n * sizeof(int));
-    bool* visited = (bool*)malloc(n * sizeof(bool));
+    // Resolve the metric once; the loop below only indexes an int array
+    const int* weights = csrWeights(csr, metric);
+    int* dist = ctx->dist;
+    int* parent = ctx->parent;
+    MinHeap* pq = &ctx->heap;
     
     // Initialize
-    for (int i = 0; i < n; i++) {
-        dist[i] = INFINITY_DIST;
-        parent[i] = -1;
-        visited[i] = false;
-    }
-    
+    touchCity(ctx, start);
+    touchCity(ctx, end);
     dist[start] = 0;
-    PQNode* pq = NULL;
-    enqueuePQ(&pq, start, 0);
+    heapPushOrDecrease(pq, start, 0);
     
     // Main algorithm
-    while (!isPQEmpty(pq)) {
-        int current = dequeuePQ(&pq);
+    while (!heapIsEmpty(pq)) {
+        int current = heapPopMin(pq);
         
-        if (visited[current]) continue;
-        visited[current] = true;
+        if (isVisited(ctx, current)) continue;
+        markVisited(ctx, current);
         
         if (current == end) break;
         
         // Explore neighbors
-        AdjNode* neighbor = graph->adjList[current];
-        while (neighbor) {
-            int next = neighbor->cityIndex;
-            int weight = getWeight(neighbor, weightType);
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++) {
+            if (!(modes & modeBit(csr->modeId[e]))) continue;
+            int next = csr->target[e];
+            int weight = weights[e];
             int newDist = dist[current] + weight;
             
+            touchCity(ctx, next);
             if (newDist < dist[next]) {
                 dist[next] = newDist;
                 parent[next] = current;
-                enqueuePQ(&pq, next, newDist);
+                ctx->parentEdge[next] = e;
+                heapPushOrDecrease(pq, next, newDist);
             }
-            
-            neighbor = neighbor->next;
         }
     }
     
     // Check if path exists
     if (dist[end] == INFINITY_DIST) {
-        free(dist);
-        free(parent);
-        free(visited);
         return NULL;
     }
+    return buildPathResult(csr, ctx, end, "Dijkstra's Algorithm");
+}
+
+/**
+ * One-to-all Dijkstra: settles every city reachable from source, or with
+ * reverse every city that can reach it. Distances stay in ctx (read them
+ * with queryDistance); parentEdge is always a forward CSR edge id.
+ */
+bool dijkstraOneToAll(Graph* graph, QueryContext* ctx, int source, WeightMetric metric, bool reverse) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(ctx, csr->numCities)) return false;
+    
+    const int* weights = csrWeights(csr, metric);
+    const int* offsets = reverse ? csr->revOffsets : csr->offsets;
+    int* dist = ctx->dist;
+    MinHeap* pq = &ctx->heap;
+    
+    touchCity(ctx, source);
+    dist[source] = 0;
+    heapPushOrDecrease(pq, source, 0);
+    
+    while (!heapIsEmpty(pq)) {
+        int current = heapPopMin(pq);
+        markVisited(ctx, current);
+        
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int e = reverse ? csr->revEdge[i] : i;
+            int next = reverse ? csr->revSource[i] : csr->target[e];
+            int newDist = dist[current] + weights[e];
+            
+            touchCity(ctx, next);
+            if (newDist < dist[next]) {
+                dist[next] = newDist;
+                ctx->parent[next] = current;
+                ctx->parentEdge[next] = e;
+                heapPushOrDecrease(pq, next, newDist);
+            }
+        }
+    }
     
-    // Reconstruct path
-    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
-    strcpy(result->algorithm, "Dijkstra's Algorithm");
-    result->pathLength = 0;
-    
-    int temp[MAX_CITIES];
-    int tempLen = 0;
-    int current = end;
+    return true;
+}
+
+PathResult* dijkstra(Graph* graph, const char* startId, const char* endId, const char* weightType) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
     
-    while (current != -1) {
-        temp[tempLen++] = current;
-        current = parent[current];
+    if (start == -1 || end == -1) {
+        return NULL;
     }
     
-    // Reverse path
-    for (int i = 0; i < tempLen; i++) {
-        result->path[i] = temp[tempLen - 1 - i];
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (!ctx) return NULL;
+    return dijkstraQuery(graph, ctx, start, end, parseWeightType(weightType), MODE_MASK_ALL);
+}
+
+/**
+ * Bidirectional Dijkstra
+ * Grows a forward tree from start and a backward tree (over incoming edges)
+ * from end, and stops once the two queue minima together cannot beat the
+ * best start -> end connection seen so far.
+ */
+PathResult* bidirectionalDijkstraQuery(Graph* graph, QueryContext* forward, QueryContext* backward,
+                                       int start, int end, WeightMetric metric, ModeMask modes) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(forward, csr->numCities) || !beginQuery(backward, csr->numCities)) {
+        return NULL;
     }
-    result->pathLength = tempLen;
     
-    // Calculate metrics
-    result->totalDistance = 0;
-    result->totalTime = 0;
-    result->totalCost = 0;
+    const int* weights = csrWeights(csr, metric);
     
-    for (int i = 0; i < result->pathLength - 1; i++) {
-        int from = result->path[i];
-        int to = result->path[i + 1];
-        
-        AdjNode* node = graph->adjList[from];
-        while (node && node->cityIndex != to) {
-            node = node->next;
-        }
+    // Initialize
+    touchCity(forward, start);
+    touchCity(backward, end);
+    forward->dist[start] = 0;
+    backward->dist[end] = 0;
+    heapPushOrDecrease(&forward->heap, start, 0);
+    heapPushOrDecrease(&backward->heap, end, 0);
+    
+    // Best connection: forward tree to meetFrom, edge meetEdge, backward tree from meetTo
+    int best = (start == end) ? 0 : INFINITY_DIST;
+    int meetFrom = start, meetEdge = -1;
+    
+    while (!heapIsEmpty(&forward->heap) && !heapIsEmpty(&backward->heap)) {
+        int topForward = heapMinPriority(&forward->heap);
+        int topBackward = heapMinPriority(&backward->heap);
+        if (best != INFINITY_DIST && topForward + topBackward >= best) break;
         
-        if (node) {
-            result->totalDistance += node->distance;
-            result->totalTime += node->time;
-            result->totalCost += node->cost;
+        if (topForward <= topBackward) {
+            int current = heapPopMin(&forward->heap);
+            if (isVisited(forward, current)) continue;
+            markVisited(forward, current);
+            
+            for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++) {
+                if (!(modes & modeBit(csr->modeId[e]))) continue;
+                int next = csr->target[e];
+                int newDist = forward->dist[current] + weights[e];
+                
+                touchCity(forward, next);
+                if (newDist < forward->dist[next]) {
+                    forward->dist[next] = newDist;
+                    forward->parent[next] = current;
+                    forward->parentEdge[next] = e;
+                    heapPushOrDecrease(&forward->heap, next, newDist);
+                }
+                
+                touchCity(backward, next);
+                if (backward->dist[next] != INFINITY_DIST &&
+                    newDist + backward->dist[next] < best) {
+                    best = newDist + backward->dist[next];
+                    meetFrom = current;
+                    meetEdge = e;
+                }
+            }
+        } else {
+            int current = heapPopMin(&backward->heap);
+            if (isVisited(backward, current)) continue;
+            markVisited(backward, current);
+            
+            // Backward tree: parent points towards end, parentEdge is the forward edge
+            for (int r = csr->revOffsets[current]; r < csr->revOffsets[current + 1]; r++) {
+                int prev = csr->revSource[r];
+                int e = csr->revEdge[r];
+                if (!(modes & modeBit(csr->modeId[e]))) continue;
+                int newDist = backward->dist[current] + weights[e];
+                
+                touchCity(backward, prev);
+                if (newDist < backward->dist[prev]) {
+                    backward->dist[prev] = newDist;
+                    backward->parent[prev] = current;
+                    backward->parentEdge[prev] = e;
+                    heapPushOrDecrease(&backward->heap, prev, newDist);
+                }
+                
+                touchCity(forward, prev);
+                if (forward->dist[prev] != INFINITY_DIST &&
+                    forward->dist[prev] + newDist < best) {
+                    best = forward->dist[prev] + newDist;
+                    meetFrom = prev;
+                    meetEdge = e;
+                }
+            }
         }
     }
     
-    free(dist);
-    free(parent);
-    free(visited);
+    // Check if path exists
+    if (best == INFINITY_DIST) {
+        return NULL;
+    }
     
-    return result;
+    // Stitch: start .. meetFrom (forward tree), meetEdge, target .. end (backward tree)
+    int* edges = forward->scratch;
+    int numEdges = 0;
+    for (int current = meetFrom; forward->parent[current] != -1; current = forward->parent[current]) {
+        numEdges++;
+    }
+    int i = numEdges;
+    for (int current = meetFrom; forward->parent[current] != -1; current = forward->parent[current]) {
+        edges[--i] = forward->parentEdge[current];
+    }
+    if (meetEdge != -1) {
+        edges[numEdges++] = meetEdge;
+        for (int current = csr->target[meetEdge]; backward->parent[current] != -1;
+             current = backward->parent[current]) {
+            edges[numEdges++] = backward->parentEdge[current];
+        }
+    }
+    
+    return buildPathFromEdges(csr, start, edges, numEdges, "Bidirectional Dijkstra");
 }
 
-/**
- * A* Algorithm
- * Enhanced Dijkstra with heuristic
- */
-PathResult* aStar(Graph* graph, const char* startId, const char* endId, const char* weightType) {
+PathResult* bidirectionalDijkstra(Graph* graph, const char* startId, const char* endId,
+                                  const char* weightType) {
     int start = findCityIndex(graph, startId);
     int end = findCityIndex(graph, endId);
     
@@ -174,115 +302,93 @@ PathResult* aStar(Graph* graph, const char* startId, const char* endId, const ch
         return NULL;
     }
     
-    int n = graph->numCities;
-    int* gScore = (int*)malloc(n * sizeof(int));
-    int* fScore = (int*)malloc(n * sizeof(int));
-    int* parent = (int*)malloc(n * sizeof(int));
-    bool* visited = (bool*)malloc(n * sizeof(bool));
+    QueryContext* forward = getGraphQueryContext(graph, false);
+    QueryContext* backward = getGraphQueryContext(graph, true);
+    if (!forward || !backward) return NULL;
+    return bidirectionalDijkstraQuery(graph, forward, backward, start, end,
+                                      parseWeightType(weightType), MODE_MASK_ALL);
+}
+
+/**
+ * A* lower bound on the remaining cost from city to end. Landmarks give an
+ * exact triangle-inequality bound for every metric. Without them, fall back
+ * to chord km for distance and to 0 (Dijkstra order) for time and cost,
+ * which a km estimate would overestimate.
+ */
+static int aStarHeuristic(const CSRGraph* csr, const LandmarkSet* landmarks, WeightMetric metric,
+                          int city, int end) {
+    if (landmarks) return landmarkHeuristic(landmarks, city, end);
+    if (metric == METRIC_DISTANCE) return (int)chordDistance(csr, city, end);
+    return 0;
+}
+
+/**
+ * A* Algorithm
+ * Enhanced Dijkstra with heuristic. Uses graph->landmarks[metric] when it
+ * matches the current graph version (see prepareLandmarks); the bounds stay
+ * admissible when modes removes edges.
+ */
+PathResult* aStarQuery(Graph* graph, QueryContext* ctx, int start, int end, WeightMetric metric,
+                       ModeMask modes) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(ctx, csr->numCities)) return NULL;
+    
+    const int* weights = csrWeights(csr, metric);
+    const LandmarkSet* landmarks = graph->landmarks[metric];
+    if (landmarks && landmarks->graphVersion != graph->version) landmarks = NULL;
+    int* gScore = ctx->dist;
+    int* fScore = ctx->score;
+    int* parent = ctx->parent;
+    MinHeap* pq = &ctx->heap;
     
     // Initialize
-    for (int i = 0; i < n; i++) {
-        gScore[i] = INFINITY_DIST;
-        fScore[i] = INFINITY_DIST;
-        parent[i] = -1;
-        visited[i] = false;
-    }
-    
+    touchCity(ctx, start);
+    touchCity(ctx, end);
     gScore[start] = 0;
-    fScore[start] = (int)calculateHeuristic(graph, start, end);
+    fScore[start] = aStarHeuristic(csr, landmarks, metric, start, end);
     
-    PQNode* pq = NULL;
-    enqueuePQ(&pq, start, fScore[start]);
+    heapPushOrDecrease(pq, start, fScore[start]);
     
     // Main algorithm
-    while (!isPQEmpty(pq)) {
-        int current = dequeuePQ(&pq);
+    while (!heapIsEmpty(pq)) {
+        int current = heapPopMin(pq);
         
-        if (visited[current]) continue;
-        visited[current] = true;
+        if (isVisited(ctx, current)) continue;
+        markVisited(ctx, current);
         
         if (current == end) break;
         
         // Explore neighbors
-        AdjNode* neighbor = graph->adjList[current];
-        while (neighbor) {
-            int next = neighbor->cityIndex;
-            int weight = getWeight(neighbor, weightType);
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++) {
+            if (!(modes & modeBit(csr->modeId[e]))) continue;
+            int next = csr->target[e];
+            int weight = weights[e];
             int tentativeG = gScore[current] + weight;
             
+            touchCity(ctx, next);
             if (tentativeG < gScore[next]) {
+                // h(next) is fixed for the query: compute it on first reach,
+                // afterwards recover it from the stored f - g
+                int h = gScore[next] == INFINITY_DIST ?
+                        aStarHeuristic(csr, landmarks, metric, next, end) :
+                        fScore[next] - gScore[next];
                 parent[next] = current;
+                ctx->parentEdge[next] = e;
                 gScore[next] = tentativeG;
-                fScore[next] = tentativeG + (int)calculateHeuristic(graph, next, end);
-                enqueuePQ(&pq, next, fScore[next]);
+                fScore[next] = tentativeG + h;
+                heapPushOrDecrease(pq, next, fScore[next]);
             }
-            
-            neighbor = neighbor->next;
         }
     }
     
     // Check if path exists
     if (gScore[end] == INFINITY_DIST) {
-        free(gScore);
-        free(fScore);
-        free(parent);
-        free(visited);
         return NULL;
     }
-    
-    // Reconstruct path (same as Dijkstra)
-    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
-    strcpy(result->algorithm, "A* Algorithm");
-    result->pathLength = 0;
-    
-    int temp[MAX_CITIES];
-    int tempLen = 0;
-    int current = end;
-    
-    while (current != -1) {
-        temp[tempLen++] = current;
-        current = parent[current];
-    }
-    
-    for (int i = 0; i < tempLen; i++) {
-        result->path[i] = temp[tempLen - 1 - i];
-    }
-    result->pathLength = tempLen;
-    
-    // Calculate metrics
-    result->totalDistance = 0;
-    result->totalTime = 0;
-    result->totalCost = 0;
-    
-    for (int i = 0; i < result->pathLength - 1; i++) {
-        int from = result->path[i];
-        int to = result->path[i + 1];
-        
-        AdjNode* node = graph->adjList[from];
-        while (node && node->cityIndex != to) {
-            node = node->next;
-        }
-        
-        if (node) {
-            result->totalDistance += node->distance;
-            result->totalTime += node->time;
-            result->totalCost += node->cost;
-        }
-    }
-    
-    free(gScore);
-    free(fScore);
-    free(parent);
-    free(visited);
-    
-    return result;
+    return buildPathResult(csr, ctx, end, "A* Algorithm");
 }
 
-/**
- * Breadth-First Search (BFS)
- * Finds path with minimum number of stops
- */
-PathResult* bfs(Graph* graph, const char* startId, const char* endId) {
+PathResult* aStar(Graph* graph, const char* startId, const char* endId, const char* weightType) {
     int start = findCityIndex(graph, startId);
     int end = findCityIndex(graph, endId);
     
@@ -290,19 +396,29 @@ PathResult* bfs(Graph* graph, const char* startId, const char* endId) {
         return NULL;
     }
     
-    int n = graph->numCities;
-    bool* visited = (bool*)malloc(n * sizeof(bool));
-    int* parent = (int*)malloc(n * sizeof(int));
-    int* queue = (int*)malloc(n * sizeof(int));
+    WeightMetric metric = parseWeightType(weightType);
+    prepareLandmarks(graph, metric, ALT_DEFAULT_LANDMARKS);
     
-    for (int i = 0; i < n; i++) {
-        visited[i] = false;
-        parent[i] = -1;
-    }
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (!ctx) return NULL;
+    return aStarQuery(graph, ctx, start, end, metric, MODE_MASK_ALL);
+}
+
+/**
+ * Breadth-First Search (BFS)
+ * Finds path with minimum number of stops over edges whose mode is in modes
+ */
+PathResult* bfsQuery(Graph* graph, QueryContext* ctx, int start, int end, ModeMask modes) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(ctx, csr->numCities)) return NULL;
+    
+    int* parent = ctx->parent;
+    int* queue = ctx->scratch;
     
     int front = 0, rear = 0;
     queue[rear++] = start;
-    visited[start] = true;
+    touchCity(ctx, start);
+    markVisited(ctx, start);
     
     bool found = false;
     
@@ -314,100 +430,93 @@ PathResult* bfs(Graph* graph, const char* startId, const char* endId) {
             break;
         }
         
-        AdjNode* neighbor = graph->adjList[current];
-        while (neighbor) {
-            int next = neighbor->cityIndex;
-            if (!visited[next]) {
-                visited[next] = true;
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++) {
+            if (!(modes & modeBit(csr->modeId[e]))) continue;
+            int next = csr->target[e];
+            if (!isVisited(ctx, next)) {
+                markVisited(ctx, next);
+                touchCity(ctx, next);
                 parent[next] = current;
+                ctx->parentEdge[next] = e;
                 queue[rear++] = next;
             }
-            neighbor = neighbor->next;
         }
     }
     
     if (!found) {
-        free(visited);
-        free(parent);
-        free(queue);
         return NULL;
     }
+    return buildPathResult(csr, ctx, end, "Breadth-First Search (BFS)");
+}
+
+PathResult* bfs(Graph* graph, const char* startId, const char* endId) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
     
-    // Reconstruct path
-    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
-    strcpy(result->algorithm, "Breadth-First Search (BFS)");
-    
-    int temp[MAX_CITIES];
-    int tempLen = 0;
-    int current = end;
-    
-    while (current != -1) {
-        temp[tempLen++] = current;
-        current = parent[current];
-    }
-    
-    for (int i = 0; i < tempLen; i++) {
-        result->path[i] = temp[tempLen - 1 - i];
-    }
-    result->pathLength = tempLen;
-    
-    // Calculate metrics
-    result->totalDistance = 0;
-    result->totalTime = 0;
-    result->totalCost = 0;
-    
-    for (int i = 0; i < result->pathLength - 1; i++) {
-        int from = result->path[i];
-        int to = result->path[i + 1];
-        
-        AdjNode* node = graph->adjList[from];
-        while (node && node->cityIndex != to) {
-            node = node->next;
-        }
-        
-        if (node) {
-            result->totalDistance += node->distance;
-            result->totalTime += node->time;
-            result->totalCost += node->cost;
-        }
+    if (start == -1 || end == -1) {
+        return NULL;
     }
     
-    free(visited);
-    free(parent);
-    free(queue);
-    
-    return result;
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (!ctx) return NULL;
+    return bfsQuery(graph, ctx, start, end, MODE_MASK_ALL);
 }
 
 /**
  * Depth-First Search (DFS) Helper
+ * Iterative so deep graphs cannot overflow the call stack; cursor[v] is the
+ * next edge of v to try, which visits cities in the same order as recursion.
  */
-bool dfsHelper(Graph* graph, int current, int end, bool* visited, int* parent) {
-    visited[current] = true;
-    
-    if (current == end) {
-        return true;
-    }
-    
-    AdjNode* neighbor = graph->adjList[current];
-    while (neighbor) {
-        int next = neighbor->cityIndex;
-        if (!visited[next]) {
+static bool dfsHelper(const CSRGraph* csr, int start, int end, ModeMask modes, QueryContext* ctx) {
+    int* stack = ctx->scratch;
+    int* cursor = ctx->cursor;
+    int* parent = ctx->parent;
+    
+    int top = 0;
+    stack[top++] = start;
+    touchCity(ctx, start);
+    markVisited(ctx, start);
+    cursor[start] = csr->offsets[start];
+    bool found = (start == end);
+    
+    while (top > 0 && !found) {
+        int current = stack[top - 1];
+        
+        if (cursor[current] == csr->offsets[current + 1]) {
+            top--;
+            continue;
+        }
+        
+        int e = cursor[current]++;
+        int next = csr->target[e];
+        if ((modes & modeBit(csr->modeId[e])) && !isVisited(ctx, next)) {
+            markVisited(ctx, next);
+            touchCity(ctx, next);
             parent[next] = current;
-            if (dfsHelper(graph, next, end, visited, parent)) {
-                return true;
-            }
+            ctx->parentEdge[next] = e;
+            cursor[next] = csr->offsets[next];
+            stack[top++] = next;
+            found = (next == end);
         }
-        neighbor = neighbor->next;
     }
     
-    return false;
+    return found;
 }
 
 /**
  * Depth-First Search (DFS)
  * Finds any path (may not be optimal)
  */
+PathResult* dfsQuery(Graph* graph, QueryContext* ctx, int start, int end, ModeMask modes) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !beginQuery(ctx, csr->numCities)) return NULL;
+    
+    if (!dfsHelper(csr, start, end, modes, ctx)) {
+        return NULL;
+    }
+    return buildPathResult(csr, ctx, end, "Depth-First Search (DFS)");
+}
+
 PathResult* dfs(Graph* graph, const char* startId, const char* endId) {
     int start = findCityIndex(graph, startId);
     int end = findCityIndex(graph, endId);
@@ -416,64 +525,7 @@ PathResult* dfs(Graph* graph, const char* startId, const char* endId) {
         return NULL;
     }
     
-    int n = graph->numCities;
-    bool* visited = (bool*)malloc(n * sizeof(bool));
-    int* parent = (int*)malloc(n * sizeof(int));
-    
-    for (int i = 0; i < n; i++) {
-        visited[i] = false;
-        parent[i] = -1;
-    }
-    
-    bool found = dfsHelper(graph, start, end, visited, parent);
-    
-    if (!found) {
-        free(visited);
-        free(parent);
-        return NULL;
-    }
-    
-    // Reconstruct path
-    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
-    strcpy(result->algorithm, "Depth-First Search (DFS)");
-    
-    int temp[MAX_CITIES];
-    int tempLen = 0;
-    int current = end;
-    
-    while (current != -1) {
-        temp[tempLen++] = current;
-        current = parent[current];
-    }
-    
-    for (int i = 0; i < tempLen; i++) {
-        result->path[i] = temp[tempLen - 1 - i];
-    }
-    result->pathLength = tempLen;
-    
-    // Calculate metrics
-    result->totalDistance = 0;
-    result->totalTime = 0;
-    result->totalCost = 0;
-    
-    for (int i = 0; i < result->pathLength - 1; i++) {
-        int from = result->path[i];
-        int to = result->path[i + 1];
-        
-        AdjNode* node = graph->adjList[from];
-        while (node && node->cityIndex != to) {
-            node = node->next;
-        }
-        
-        if (node) {
-            result->totalDistance += node->distance;
-            result->totalTime += node->time;
-            result->totalCost += node->cost;
-        }
-    }
-    
-    free(visited);
-    free(parent);
-    
-    return result;
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (!ctx) return NULL;
+    return dfsQuery(graph, ctx, start, end, MODE_MASK_ALL);
 }
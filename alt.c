@@ -0,0 +1,144 @@
+/**
+ * ALT Heuristic Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Landmarks are picked greedily as the city farthest from every landmark
+ * chosen so far, which spreads them around the edge of the network where
+ * the triangle-inequality bounds are tightest.
+ */
+
+#include "alt.h"
+
+/**
+ * Copy one-to-all distances out of the context into column l of table
+ */
+static void storeColumn(const QueryContext* ctx, int* table, int n, int k, int l) {
+    for (int v = 0; v < n; v++) {
+        table[v * k + l] = queryDistance(ctx, v);
+    }
+}
+
+/**
+ * Pick landmarks and precompute their distances for one metric
+ */
+LandmarkSet* buildLandmarks(Graph* graph, WeightMetric metric, int numLandmarks) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || numLandmarks <= 0) return NULL;
+    
+    int n = csr->numCities;
+    int k = numLandmarks < n ? numLandmarks : n;
+    
+    LandmarkSet* set = (LandmarkSet*)calloc(1, sizeof(LandmarkSet));
+    QueryContext* ctx = createQueryContext(n);
+    if (!set || !ctx) {
+        free(set);
+        destroyQueryContext(ctx);
+        return NULL;
+    }
+    
+    set->metric = metric;
+    set->graphVersion = graph->version;
+    set->numCities = n;
+    set->numLandmarks = k;
+    set->landmarks = (int*)malloc((k > 0 ? k : 1) * sizeof(int));
+    set->fromLandmark = (int*)malloc(((size_t)n * k > 0 ? (size_t)n * k : 1) * sizeof(int));
+    set->toLandmark = (int*)malloc(((size_t)n * k > 0 ? (size_t)n * k : 1) * sizeof(int));
+    if (!set->landmarks || !set->fromLandmark || !set->toLandmark) {
+        fprintf(stderr, "Error: Memory allocation failed for landmarks\n");
+        destroyLandmarks(set);
+        destroyQueryContext(ctx);
+        return NULL;
+    }
+    
+    // Seed: the city farthest from city 0
+    int next = 0;
+    if (n > 0 && dijkstraOneToAll(graph, ctx, 0, metric, false)) {
+        int farthest = -1;
+        for (int v = 0; v < n; v++) {
+            int d = queryDistance(ctx, v);
+            if (d != INFINITY_DIST && d > farthest) {
+                farthest = d;
+                next = v;
+            }
+        }
+    }
+    
+    for (int l = 0; l < k; l++) {
+        set->landmarks[l] = next;
+        
+        if (!dijkstraOneToAll(graph, ctx, next, metric, false)) break;
+        storeColumn(ctx, set->fromLandmark, n, k, l);
+        if (!dijkstraOneToAll(graph, ctx, next, metric, true)) break;
+        storeColumn(ctx, set->toLandmark, n, k, l);
+        
+        // Next landmark: maximise the distance to the nearest chosen one;
+        // cities no landmark reaches yet win outright
+        long bestScore = -1;
+        for (int v = 0; v < n; v++) {
+            long nearest = INFINITY_DIST;
+            for (int j = 0; j <= l; j++) {
+                int d = set->fromLandmark[v * k + j];
+                if (d < nearest) nearest = d;
+            }
+            if (nearest > bestScore) {
+                bestScore = nearest;
+                next = v;
+            }
+        }
+    }
+    
+    destroyQueryContext(ctx);
+    return set;
+}
+
+/**
+ * Destroy landmark set and free memory
+ */
+void destroyLandmarks(LandmarkSet* landmarks) {
+    if (!landmarks) return;
+    free(landmarks->landmarks);
+    free(landmarks->fromLandmark);
+    free(landmarks->toLandmark);
+    free(landmarks);
+}
+
+/**
+ * Make sure graph->landmarks[metric] exists for the current graph version
+ */
+bool prepareLandmarks(Graph* graph, WeightMetric metric, int numLandmarks) {
+    LandmarkSet* current = graph->landmarks[metric];
+    if (current && current->graphVersion == graph->version &&
+        current->numLandmarks == (numLandmarks < graph->numCities ? numLandmarks : graph->numCities)) {
+        return true;
+    }
+    
+    LandmarkSet* fresh = buildLandmarks(graph, metric, numLandmarks);
+    if (!fresh) return false;
+    destroyLandmarks(current);
+    graph->landmarks[metric] = fresh;
+    return true;
+}
+
+/**
+ * Lower bound on d(city, target) from every landmark's two triangle inequalities
+ */
+int landmarkHeuristic(const LandmarkSet* landmarks, int city, int target) {
+    int k = landmarks->numLandmarks;
+    const int* fromCity = &landmarks->fromLandmark[city * k];
+    const int* fromTarget = &landmarks->fromLandmark[target * k];
+    const int* toCity = &landmarks->toLandmark[city * k];
+    const int* toTarget = &landmarks->toLandmark[target * k];
+    
+    int best = 0;
+    for (int l = 0; l < k; l++) {
+        if (fromTarget[l] != INFINITY_DIST && fromCity[l] != INFINITY_DIST &&
+            fromTarget[l] - fromCity[l] > best) {
+            best = fromTarget[l] - fromCity[l];
+        }
+        if (toCity[l] != INFINITY_DIST && toTarget[l] != INFINITY_DIST &&
+            toCity[l] - toTarget[l] > best) {
+            best = toCity[l] - toTarget[l];
+        }
+    }
+    return best;
+}
@@ -0,0 +1,33 @@
+/**
+ * ALT (A*, Landmarks, Triangle inequality) Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef ALT_H
+#define ALT_H
+
+#include "graph.h"
+#include "query.h"
+
+#define ALT_DEFAULT_LANDMARKS 8
+
+// Exact distances to and from a few landmark cities for one metric.
+// For any city v and target t, d(v, t) >= d(L, t) - d(L, v) and
+// d(v, t) >= d(v, L) - d(t, L), which gives an admissible A* heuristic in
+// the metric's own units (km, hundredths of an hour, rupees).
+struct LandmarkSet {
+    WeightMetric metric;
+    unsigned long graphVersion;   // Graph.version the distances belong to
+    int numCities;
+    int numLandmarks;
+    int* landmarks;
+    int* fromLandmark;            // [city * numLandmarks + l] = d(landmark l, city)
+    int* toLandmark;              // [city * numLandmarks + l] = d(city, landmark l)
+};
+
+LandmarkSet* buildLandmarks(Graph* graph, WeightMetric metric, int numLandmarks);
+void destroyLandmarks(LandmarkSet* landmarks);
+bool prepareLandmarks(Graph* graph, WeightMetric metric, int numLandmarks);
+int landmarkHeuristic(const LandmarkSet* landmarks, int city, int target);
+
+#endif // ALT_H
@@ -0,0 +1,75 @@
+/**
+ * Arena Allocator Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Graph-owned storage for adjacency nodes: building a graph costs a few
+ * dozen mallocs instead of one per edge, and teardown frees whole blocks.
+ */
+
+#include <stdlib.h>
+#include "arena.h"
+
+#define ARENA_ALIGNMENT 16
+
+static size_t alignUp(size_t bytes) {
+    return (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * Initialize an empty arena (no memory is reserved until first use)
+ */
+void arenaInit(Arena* arena) {
+    arena->head = NULL;
+    arena->nextBlockSize = ARENA_FIRST_BLOCK_SIZE;
+    arena->bytesReserved = 0;
+    arena->bytesUsed = 0;
+    arena->numBlocks = 0;
+}
+
+/**
+ * Allocate bytes from the arena, 16-byte aligned (NULL on failure)
+ */
+void* arenaAlloc(Arena* arena, size_t bytes) {
+    size_t header = alignUp(sizeof(ArenaBlock));
+    bytes = alignUp(bytes);
+    
+    ArenaBlock* block = arena->head;
+    if (!block || block->used + bytes > block->capacity) {
+        size_t capacity = arena->nextBlockSize;
+        while (capacity < bytes) {
+            capacity *= 2;
+        }
+        
+        block = (ArenaBlock*)malloc(header + capacity);
+        if (!block) return NULL;
+        
+        block->next = arena->head;
+        block->used = 0;
+        block->capacity = capacity;
+        arena->head = block;
+        arena->bytesReserved += header + capacity;
+        arena->numBlocks++;
+        
+        if (arena->nextBlockSize < ARENA_MAX_BLOCK_SIZE) {
+            arena->nextBlockSize *= 2;
+        }
+    }
+    
+    void* memory = (char*)block + header + block->used;
+    block->used += bytes;
+    arena->bytesUsed += bytes;
+    return memory;
+}
+
+/**
+ * Release every block owned by the arena
+ */
+void arenaFree(Arena* arena) {
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arenaInit(arena);
+}
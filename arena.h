@@ -0,0 +1,34 @@
+/**
+ * Arena Allocator Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_FIRST_BLOCK_SIZE 4096
+#define ARENA_MAX_BLOCK_SIZE (64u * 1024 * 1024)
+
+// One large allocation carved up by arenaAlloc
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t capacity;
+} ArenaBlock;
+
+// Bump allocator; everything is released at once by arenaFree
+typedef struct {
+    ArenaBlock* head;
+    size_t nextBlockSize;     // doubles per block up to ARENA_MAX_BLOCK_SIZE
+    size_t bytesReserved;
+    size_t bytesUsed;
+    int numBlocks;
+} Arena;
+
+void arenaInit(Arena* arena);
+void* arenaAlloc(Arena* arena, size_t bytes);
+void arenaFree(Arena* arena);
+
+#endif // ARENA_H
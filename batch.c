@@ -0,0 +1,231 @@
+/**
+ * Batch Query Engine Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Workers sleep on a condition variable between batches. Inside a batch
+ * they claim query indices from an atomic counter and store each result at
+ * its own index, so output order always matches input order.
+ */
+
+#include "batch.h"
+#include "matrix.h"
+#include "alt.h"
+
+static const char* algorithmNames[ALGORITHM_COUNT] = {
+    "dijkstra", "astar", "bidirectional", "bfs", "dfs"
+};
+
+/**
+ * Map an algorithm name to QueryAlgorithm, -1 if unknown
+ */
+int parseAlgorithm(const char* name) {
+    for (int a = 0; a < ALGORITHM_COUNT; a++) {
+        if (strcmp(name, algorithmNames[a]) == 0) return a;
+    }
+    if (strcmp(name, "a*") == 0) return ALGORITHM_ASTAR;
+    return -1;
+}
+
+const char* getAlgorithmName(QueryAlgorithm algorithm) {
+    return algorithm >= 0 && algorithm < ALGORITHM_COUNT ? algorithmNames[algorithm] : "unknown";
+}
+
+/**
+ * Answer one query with caller-owned contexts (thread-safe on a frozen graph)
+ */
+PathResult* runQuery(Graph* graph, QueryContext* forward, QueryContext* backward,
+                     const BatchQuery* query) {
+    if (query->start < 0 || query->start >= graph->numCities ||
+        query->end < 0 || query->end >= graph->numCities) {
+        return NULL;
+    }
+    
+    switch (query->algorithm) {
+        case ALGORITHM_DIJKSTRA:
+            return dijkstraQuery(graph, forward, query->start, query->end, query->metric,
+                                 query->modes);
+        case ALGORITHM_ASTAR:
+            return aStarQuery(graph, forward, query->start, query->end, query->metric,
+                              query->modes);
+        case ALGORITHM_BIDIRECTIONAL:
+            return bidirectionalDijkstraQuery(graph, forward, backward, query->start, query->end,
+                                              query->metric, query->modes);
+        case ALGORITHM_BFS:
+            return bfsQuery(graph, forward, query->start, query->end, query->modes);
+        case ALGORITHM_DFS:
+            return dfsQuery(graph, forward, query->start, query->end, query->modes);
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * Unfiltered Dijkstra queries walk a cached tree when the pool has a cache
+ */
+static PathResult* answerPoolQuery(QueryPool* pool, int worker, const BatchQuery* query) {
+    if (pool->treeCache && query->algorithm == ALGORITHM_DIJKSTRA &&
+        query->modes == MODE_MASK_ALL) {
+        return sptCacheQuery(pool->treeCache, pool->forward[worker], query->start, query->end,
+                             query->metric);
+    }
+    return runQuery(pool->graph, pool->forward[worker], pool->backward[worker], query);
+}
+
+/**
+ * Worker thread: wait for a batch, drain it, report back
+ */
+static void* poolWorker(void* arg) {
+    QueryPool* pool = (QueryPool*)arg;
+    
+    pthread_mutex_lock(&pool->lock);
+    int worker = pool->activeWorkers++;   // startup handshake hands out worker ids
+    pthread_cond_signal(&pool->workDone);
+    unsigned long seenBatch = pool->batchId;
+    
+    while (true) {
+        while (pool->batchId == seenBatch && !pool->shuttingDown) {
+            pthread_cond_wait(&pool->workReady, &pool->lock);
+        }
+        if (pool->shuttingDown) break;
+        seenBatch = pool->batchId;
+        pthread_mutex_unlock(&pool->lock);
+        
+        int i;
+        while ((i = atomic_fetch_add(&pool->nextQuery, 1)) < pool->numQueries) {
+            pool->results[i] = answerPoolQuery(pool, worker, &pool->queries[i]);
+        }
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->activeWorkers == 0) {
+            pthread_cond_signal(&pool->workDone);
+        }
+    }
+    
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Free the per-worker contexts and arrays of a pool
+ */
+static void freePoolMemory(QueryPool* pool, int numContexts) {
+    for (int t = 0; t < numContexts; t++) {
+        destroyQueryContext(pool->forward[t]);
+        destroyQueryContext(pool->backward[t]);
+    }
+    free(pool->threads);
+    free(pool->forward);
+    free(pool->backward);
+    free(pool);
+}
+
+/**
+ * Create a pool of worker threads (numThreads <= 0: one per processor)
+ */
+QueryPool* createQueryPool(Graph* graph, int numThreads) {
+    if (!freezeGraph(graph)) return NULL;
+    if (numThreads <= 0) numThreads = getDefaultThreadCount();
+    
+    QueryPool* pool = (QueryPool*)calloc(1, sizeof(QueryPool));
+    if (!pool) {
+        fprintf(stderr, "Error: Memory allocation failed for query pool\n");
+        return NULL;
+    }
+    pool->graph = graph;
+    pool->threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    pool->forward = (QueryContext**)calloc(numThreads, sizeof(QueryContext*));
+    pool->backward = (QueryContext**)calloc(numThreads, sizeof(QueryContext*));
+    if (!pool->threads || !pool->forward || !pool->backward) {
+        fprintf(stderr, "Error: Memory allocation failed for query pool\n");
+        freePoolMemory(pool, 0);
+        return NULL;
+    }
+    for (int t = 0; t < numThreads; t++) {
+        pool->forward[t] = createQueryContext(graph->numCities);
+        pool->backward[t] = createQueryContext(graph->numCities);
+        if (!pool->forward[t] || !pool->backward[t]) {
+            freePoolMemory(pool, t + 1);
+            return NULL;
+        }
+    }
+    
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->workReady, NULL);
+    pthread_cond_init(&pool->workDone, NULL);
+    atomic_init(&pool->nextQuery, 0);
+    
+    pthread_mutex_lock(&pool->lock);
+    for (int t = 0; t < numThreads; t++) {
+        if (pthread_create(&pool->threads[t], NULL, poolWorker, pool) != 0) break;
+        pool->numThreads++;
+    }
+    // Wait until every worker has taken its id
+    while (pool->activeWorkers < pool->numThreads) {
+        pthread_cond_wait(&pool->workDone, &pool->lock);
+    }
+    pool->activeWorkers = 0;
+    pthread_mutex_unlock(&pool->lock);
+    
+    // Drop the contexts of threads that failed to start
+    for (int t = pool->numThreads; t < numThreads; t++) {
+        destroyQueryContext(pool->forward[t]);
+        destroyQueryContext(pool->backward[t]);
+    }
+    if (pool->numThreads == 0) {
+        destroyQueryPool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Stop the workers and free the pool
+ */
+void destroyQueryPool(QueryPool* pool) {
+    if (!pool) return;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->shuttingDown = true;
+    pthread_cond_broadcast(&pool->workReady);
+    pthread_mutex_unlock(&pool->lock);
+    for (int t = 0; t < pool->numThreads; t++) {
+        pthread_join(pool->threads[t], NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->workReady);
+    pthread_cond_destroy(&pool->workDone);
+    
+    freePoolMemory(pool, pool->numThreads);
+}
+
+/**
+ * Answer every query; results[i] is the path for queries[i] (NULL when
+ * there is none). Blocks until the whole batch is done.
+ */
+bool runBatch(QueryPool* pool, const BatchQuery* queries, int numQueries, PathResult** results) {
+    Graph* graph = pool->graph;
+    if (!freezeGraph(graph)) return false;
+    
+    // Shared lazy state must exist before workers read it
+    bool needLandmarks[METRIC_COUNT] = {false};
+    for (int i = 0; i < numQueries; i++) {
+        if (queries[i].algorithm == ALGORITHM_ASTAR) needLandmarks[queries[i].metric] = true;
+    }
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        if (needLandmarks[m]) prepareLandmarks(graph, (WeightMetric)m, ALT_DEFAULT_LANDMARKS);
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->queries = queries;
+    pool->results = results;
+    pool->numQueries = numQueries;
+    atomic_store(&pool->nextQuery, 0);
+    pool->activeWorkers = pool->numThreads;
+    pool->batchId++;
+    pthread_cond_broadcast(&pool->workReady);
+    while (pool->activeWorkers > 0) {
+        pthread_cond_wait(&pool->workDone, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * Batch Query Engine Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "graph.h"
+#include "query.h"
+#include "sptcache.h"
+
+typedef enum {
+    ALGORITHM_DIJKSTRA,
+    ALGORITHM_ASTAR,
+    ALGORITHM_BIDIRECTIONAL,
+    ALGORITHM_BFS,
+    ALGORITHM_DFS,
+    ALGORITHM_COUNT
+} QueryAlgorithm;
+
+// One independent route query by city index
+typedef struct {
+    int start;
+    int end;
+    QueryAlgorithm algorithm;
+    WeightMetric metric;      // ignored by BFS/DFS
+    ModeMask modes;           // allowed transport modes
+} BatchQuery;
+
+// Fixed set of worker threads, each with its own forward/backward
+// QueryContext, answering batches over one shared frozen Graph.
+// The graph must not be modified while a batch is running.
+typedef struct {
+    Graph* graph;
+    int numThreads;
+    pthread_t* threads;
+    QueryContext** forward;
+    QueryContext** backward;
+    pthread_mutex_t lock;
+    pthread_cond_t workReady;
+    pthread_cond_t workDone;
+    unsigned long batchId;    // bumped to wake workers for a new batch
+    int activeWorkers;        // workers still busy with the current batch
+    bool shuttingDown;
+    const BatchQuery* queries;
+    PathResult** results;
+    int numQueries;
+    atomic_int nextQuery;
+    SPTCache* treeCache;      // optional, set by the caller: answers unfiltered Dijkstra queries
+} QueryPool;
+
+QueryPool* createQueryPool(Graph* graph, int numThreads);
+void destroyQueryPool(QueryPool* pool);
+bool runBatch(QueryPool* pool, const BatchQuery* queries, int numQueries, PathResult** results);
+PathResult* runQuery(Graph* graph, QueryContext* forward, QueryContext* backward,
+                     const BatchQuery* query);
+int parseAlgorithm(const char* name);
+const char* getAlgorithmName(QueryAlgorithm algorithm);
+
+#endif // BATCH_H
@@ -0,0 +1,1658 @@
+/**
+ * Benchmark Program
+ * Travel Route Planner - C Implementation
+ *
+ * Build: gcc -O2 -o bench bench.c graph.c csr.c arena.c query.c algorithms.c ch.c alt.c
+ *        matrix.c batch.c graphfile.c loader.c pareto.c ksp.c sptcache.c deltastep.c timetable.c
+ *        data.c heap.c -lm -lpthread
+ *
+ * ./bench                 fixed sections (sample, grid scaling, load, CH, ...)
+ * ./bench suite [options] every engine on generated graphs, one CSV/JSON row each
+ */
+
+#include <time.h>
+#include "graph.h"
+#include "heap.h"
+#include "query.h"
+#include "ch.h"
+#include "alt.h"
+#include "matrix.h"
+#include "batch.h"
+#include "graphfile.h"
+#include "loader.h"
+#include "pareto.h"
+#include "ksp.h"
+#include "sptcache.h"
+#include "deltastep.h"
+#include "timetable.h"
+
+void initializeSampleData(Graph* graph);
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Small deterministic generator so runs are comparable
+static unsigned int benchSeed = 12345u;
+static unsigned int nextRandom(void) {
+    benchSeed ^= benchSeed << 13;
+    benchSeed ^= benchSeed >> 17;
+    benchSeed ^= benchSeed << 5;
+    return benchSeed;
+}
+
+/**
+ * Full edge sweep: pointer-chasing adjacency lists vs the CSR snapshot
+ */
+static void benchEdgeScan(Graph* graph, const char* label) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr) return;
+
+    const int rounds = csr->numEdges > 0 ? (int)(20000000L / csr->numEdges) + 1 : 1;
+    long checksum = 0;
+
+    double start = nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < graph->numCities; i++) {
+            for (AdjNode* node = graph->adjList[i]; node; node = node->next) {
+                checksum += node->distance + node->cityIndex;
+            }
+        }
+    }
+    double listTime = nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < csr->numCities; i++) {
+            for (int e = csr->offsets[i]; e < csr->offsets[i + 1]; e++) {
+                checksum -= csr->distance[e] + csr->target[e];
+            }
+        }
+    }
+    double csrTime = nowSeconds() - start;
+
+    double edges = (double)rounds * csr->numEdges;
+    printf("%-24s adjacency list %6.2f ns/edge   CSR %6.2f ns/edge   (check %ld)\n",
+           label, listTime * 1e9 / edges, csrTime * 1e9 / edges, checksum);
+}
+
+/**
+ * Square grid of side x side cities spaced 0.05 degrees apart, each linked
+ * to its right and lower neighbour
+ */
+static Graph* buildGridGraph(int side) {
+    Graph* graph = createGraph(false);
+    if (!graph) return NULL;
+
+    char id[16], name[MAX_NAME_LENGTH];
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            snprintf(id, sizeof(id), "g%d", r * side + c);
+            snprintf(name, sizeof(name), "Grid %d,%d", r, c);
+            addCity(graph, id, name, 8.0 + r * 0.05, 68.0 + c * 0.05);
+        }
+    }
+
+    char from[16], to[16];
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            snprintf(from, sizeof(from), "g%d", r * side + c);
+            for (int dir = 0; dir < 2; dir++) {
+                int nr = r + dir, nc = c + 1 - dir;
+                if (nr >= side || nc >= side) continue;
+                snprintf(to, sizeof(to), "g%d", nr * side + nc);
+                int distance = 6 + (int)(nextRandom() % 10);
+                addRoute(graph, from, to, distance, distance / 60.0,
+                         distance * 2, "Bus");
+            }
+        }
+    }
+    return graph;
+}
+
+/**
+ * Random city in the India bounding box used by the generators
+ */
+static void randomCity(Graph* graph, int index, const char* prefix) {
+    char id[16], name[MAX_NAME_LENGTH];
+    snprintf(id, sizeof(id), "%s%d", prefix, index);
+    snprintf(name, sizeof(name), "City %d", index);
+    double latitude = 8.0 + (nextRandom() % 1000000) * (27.0 / 1000000);
+    double longitude = 68.0 + (nextRandom() % 1000000) * (29.0 / 1000000);
+    addCity(graph, id, name, latitude, longitude);
+}
+
+/**
+ * Route between two generated cities; road km is 1.0-1.5x the great-circle
+ * distance so the straight-line A* heuristic stays admissible
+ */
+static void randomRoute(Graph* graph, int from, int to) {
+    double km = calculateHeuristic(graph, from, to);
+    int distance = (int)ceil(km * (1.0 + (nextRandom() % 500) / 1000.0)) + 1;
+    bool flight = distance > 800 && nextRandom() % 3 == 0;
+    double time = flight ? 1.5 + distance / 700.0 : distance / (50.0 + nextRandom() % 30);
+    int cost = flight ? 2000 + distance * 4 : distance * (1 + (int)(nextRandom() % 3));
+    addRoute(graph, graph->cities[from].id, graph->cities[to].id, distance, time, cost,
+             flight ? "Flight" : (distance % 2 ? "Train" : "Bus"));
+}
+
+/**
+ * Random geometric graph: n random cities, each pair closer than the radius
+ * that gives roughly avgDegree neighbours is linked. Cities are bucketed in
+ * radius-sized cells so only the 9 surrounding cells are compared.
+ */
+static Graph* buildGeometricGraph(int n, double avgDegree) {
+    Graph* graph = createGraph(false);
+    if (!graph) return NULL;
+    for (int i = 0; i < n; i++) {
+        randomCity(graph, i, "r");
+    }
+
+    const double width = 29.0, height = 27.0;
+    double radius = sqrt(avgDegree * width * height / (M_PI * (n > 1 ? n : 1)));
+    int cols = (int)(width / radius) + 1, rows = (int)(height / radius) + 1;
+    int* head = (int*)malloc((size_t)cols * rows * sizeof(int));
+    int* next = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!head || !next) {
+        free(head);
+        free(next);
+        destroyGraph(graph);
+        return NULL;
+    }
+    for (int c = 0; c < cols * rows; c++) {
+        head[c] = -1;
+    }
+    for (int i = 0; i < n; i++) {
+        int cx = (int)((graph->cities[i].longitude - 68.0) / radius);
+        int cy = (int)((graph->cities[i].latitude - 8.0) / radius);
+        next[i] = head[cy * cols + cx];
+        head[cy * cols + cx] = i;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int cx = (int)((graph->cities[i].longitude - 68.0) / radius);
+        int cy = (int)((graph->cities[i].latitude - 8.0) / radius);
+        for (int y = cy - 1; y <= cy + 1; y++) {
+            for (int x = cx - 1; x <= cx + 1; x++) {
+                if (x < 0 || y < 0 || x >= cols || y >= rows) continue;
+                for (int j = head[y * cols + x]; j != -1; j = next[j]) {
+                    if (j <= i) continue;
+                    double dLat = graph->cities[i].latitude - graph->cities[j].latitude;
+                    double dLon = graph->cities[i].longitude - graph->cities[j].longitude;
+                    if (dLat * dLat + dLon * dLon <= radius * radius) randomRoute(graph, i, j);
+                }
+            }
+        }
+    }
+
+    free(head);
+    free(next);
+    return graph;
+}
+
+/**
+ * Scale-free graph (Barabasi-Albert): each new city links to `links`
+ * existing cities picked with probability proportional to their degree
+ */
+static Graph* buildScaleFreeGraph(int n, int links) {
+    Graph* graph = createGraph(false);
+    // Every edge contributes both endpoints; sampling this array is
+    // sampling by degree
+    int* endpoints = (int*)malloc(((size_t)2 * n * links + 2) * sizeof(int));
+    int* picked = (int*)malloc((links > 0 ? links : 1) * sizeof(int));
+    if (!graph || !endpoints || !picked) {
+        free(endpoints);
+        free(picked);
+        destroyGraph(graph);
+        return NULL;
+    }
+
+    size_t numEndpoints = 0;
+    for (int i = 0; i < n; i++) {
+        randomCity(graph, i, "s");
+        if (i == 0) continue;
+
+        int count = 0;
+        int want = i < links ? i : links;
+        for (int attempt = 0; count < want && attempt < 8 * links; attempt++) {
+            int target = numEndpoints == 0 ? 0 : endpoints[nextRandom() % numEndpoints];
+            bool duplicate = false;
+            for (int k = 0; k < count; k++) {
+                duplicate = duplicate || picked[k] == target;
+            }
+            if (!duplicate) picked[count++] = target;
+        }
+        for (int k = 0; k < count; k++) {
+            randomRoute(graph, i, picked[k]);
+            endpoints[numEndpoints++] = i;
+            endpoints[numEndpoints++] = picked[k];
+        }
+    }
+
+    free(endpoints);
+    free(picked);
+    return graph;
+}
+
+/**
+ * Short queries (a few hops) on a large graph: a fresh context per query
+ * pays the O(V) setup every time, a reused one only touches what it visits
+ */
+static void benchShortQueries(Graph* graph, int side) {
+    const int queries = 200;
+    int* pairs = (int*)malloc(2 * queries * sizeof(int));
+    if (!pairs) return;
+    for (int q = 0; q < queries; q++) {
+        int r = (int)(nextRandom() % (side - 5)), c = (int)(nextRandom() % (side - 5));
+        pairs[2 * q] = r * side + c;
+        pairs[2 * q + 1] = (r + 3) * side + c + 2;
+    }
+    freezeGraph(graph);
+
+    double start = nowSeconds();
+    for (int q = 0; q < queries; q++) {
+        QueryContext* ctx = createQueryContext(graph->numCities);
+        destroyPathResult(dijkstraQuery(graph, ctx, pairs[2 * q], pairs[2 * q + 1],
+                                        METRIC_DISTANCE, MODE_MASK_ALL));
+        destroyQueryContext(ctx);
+    }
+    double freshTime = nowSeconds() - start;
+
+    QueryContext* ctx = createQueryContext(graph->numCities);
+    start = nowSeconds();
+    for (int q = 0; q < queries; q++) {
+        destroyPathResult(dijkstraQuery(graph, ctx, pairs[2 * q], pairs[2 * q + 1],
+                                        METRIC_DISTANCE, MODE_MASK_ALL));
+    }
+    double reusedTime = nowSeconds() - start;
+    destroyQueryContext(ctx);
+
+    printf("short queries: fresh context %9.2f us/query   reused %7.2f us/query\n",
+           freshTime * 1e6 / queries, reusedTime * 1e6 / queries);
+    free(pairs);
+}
+
+/**
+ * Cities settled per query by Dijkstra, A* and bidirectional Dijkstra
+ * (distance metric) on the same random start/end pairs
+ */
+static void benchSettledNodes(Graph* graph, const char* label, int queries) {
+    QueryContext* forward = createQueryContext(graph->numCities);
+    QueryContext* backward = createQueryContext(graph->numCities);
+    if (!forward || !backward) return;
+
+    long settled[3] = {0, 0, 0};
+    double elapsed[3] = {0, 0, 0};
+    int n = graph->numCities;
+    for (int q = 0; q < queries; q++) {
+        int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+
+        double start = nowSeconds();
+        destroyPathResult(dijkstraQuery(graph, forward, from, to, METRIC_DISTANCE, MODE_MASK_ALL));
+        elapsed[0] += nowSeconds() - start;
+        settled[0] += forward->numSettled;
+
+        start = nowSeconds();
+        destroyPathResult(aStarQuery(graph, forward, from, to, METRIC_DISTANCE, MODE_MASK_ALL));
+        elapsed[1] += nowSeconds() - start;
+        settled[1] += forward->numSettled;
+
+        start = nowSeconds();
+        destroyPathResult(bidirectionalDijkstraQuery(graph, forward, backward, from, to,
+                                                     METRIC_DISTANCE, MODE_MASK_ALL));
+        elapsed[2] += nowSeconds() - start;
+        settled[2] += forward->numSettled + backward->numSettled;
+    }
+
+    const char* names[] = {"dijkstra", "astar", "bidirectional"};
+    for (int a = 0; a < 3; a++) {
+        printf("%-24s %-14s %10.1f settled/query %10.2f us/query\n", label, names[a],
+               (double)settled[a] / queries, elapsed[a] * 1e6 / queries);
+    }
+    destroyQueryContext(forward);
+    destroyQueryContext(backward);
+}
+
+/**
+ * Load time, memory and query latency on growing grid graphs
+ */
+static void benchGridScaling(void) {
+    const int sides[] = {10, 100, 316, 1000};
+    const int queries = 20;
+
+    printf("\n--- Grid graph scaling ---\n");
+    for (int s = 0; s < (int)(sizeof(sides) / sizeof(sides[0])); s++) {
+        double start = nowSeconds();
+        Graph* graph = buildGridGraph(sides[s]);
+        if (!graph) return;
+        double loadTime = nowSeconds() - start;
+        int n = graph->numCities;
+
+        start = nowSeconds();
+        for (int q = 0; q < queries; q++) {
+            const char* from = graph->cities[nextRandom() % n].id;
+            const char* to = graph->cities[nextRandom() % n].id;
+            destroyPathResult(dijkstra(graph, from, to, "distance"));
+        }
+        double queryTime = nowSeconds() - start;
+
+        printf("%8d cities %8d routes  load %9.2f ms  dijkstra %9.2f us/query\n",
+               n, graph->numRoutes, loadTime * 1e3, queryTime * 1e6 / queries);
+        if (s == (int)(sizeof(sides) / sizeof(sides[0])) - 1) {
+            benchEdgeScan(graph, "edge sweep");
+            benchShortQueries(graph, sides[s]);
+            benchSettledNodes(graph, "grid random pairs", queries);
+            printMemoryUsage(graph);
+        }
+        destroyGraph(graph);
+    }
+}
+
+/**
+ * All-pairs Dijkstra and A* over the 20-city sample graph
+ */
+static void benchSampleGraph(void) {
+    Graph* graph = createGraph(false);
+    initializeSampleData(graph);
+
+    const char* weights[] = {"distance", "time", "cost"};
+    const int rounds = 50;
+    int n = graph->numCities;
+
+    printf("\n--- Sample graph (%d cities, %d routes) ---\n", n, graph->numRoutes);
+    for (int w = 0; w < 3; w++) {
+        double start = nowSeconds();
+        long queries = 0;
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    destroyPathResult(dijkstra(graph, graph->cities[i].id,
+                                               graph->cities[j].id, weights[w]));
+                    queries++;
+                }
+            }
+        }
+        double dijkstraTime = nowSeconds() - start;
+
+        start = nowSeconds();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    destroyPathResult(aStar(graph, graph->cities[i].id,
+                                            graph->cities[j].id, weights[w]));
+                }
+            }
+        }
+        double aStarTime = nowSeconds() - start;
+
+        printf("%-8s  dijkstra %8.2f us/query   astar %8.2f us/query\n",
+               weights[w], dijkstraTime * 1e6 / queries, aStarTime * 1e6 / queries);
+    }
+    benchEdgeScan(graph, "edge sweep");
+    benchSettledNodes(graph, "sample random pairs", 400);
+
+    destroyGraph(graph);
+}
+
+/**
+ * Cost per call of the haversine heuristic against the precomputed chord
+ */
+static void benchHeuristic(void) {
+    const int calls = 10000000;
+    Graph* graph = buildGridGraph(100);
+    const CSRGraph* csr = graph ? freezeGraph(graph) : NULL;
+    if (!csr) {
+        destroyGraph(graph);
+        return;
+    }
+    int n = graph->numCities;
+
+    printf("\n--- A* heuristic (%d calls) ---\n", calls);
+    double sum = 0;
+    benchSeed = 99u;
+    double start = nowSeconds();
+    for (int i = 0; i < calls; i++) {
+        sum += calculateHeuristic(graph, (int)(nextRandom() % n), (int)(nextRandom() % n));
+    }
+    double haversine = nowSeconds() - start;
+
+    double chordSum = 0;
+    benchSeed = 99u;
+    start = nowSeconds();
+    for (int i = 0; i < calls; i++) {
+        chordSum += chordDistance(csr, (int)(nextRandom() % n), (int)(nextRandom() % n));
+    }
+    double chord = nowSeconds() - start;
+
+    printf("haversine  %8.2f ns/call  (mean %.1f km)\n", haversine * 1e9 / calls, sum / calls);
+    printf("chord      %8.2f ns/call  (mean %.1f km)\n", chord * 1e9 / calls, chordSum / calls);
+    destroyGraph(graph);
+}
+
+/**
+ * Nodes settled by A* with and without ALT landmarks, per metric
+ */
+static void benchLandmarks(void) {
+    const int counts[] = {0, 4, 8, 16};
+    const char* metricNames[] = {"distance", "time", "cost"};
+    const int side = 100;
+    const int queries = 200;
+
+    printf("\n--- ALT landmarks (%dx%d grid, %d queries) ---\n", side, side, queries);
+    Graph* graph = buildGridGraph(side);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    if (!graph || !ctx || !freezeGraph(graph)) {
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+        return;
+    }
+    int n = graph->numCities;
+
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+            double build = 0;
+            if (counts[c] > 0) {
+                double start = nowSeconds();
+                prepareLandmarks(graph, (WeightMetric)m, counts[c]);
+                build = nowSeconds() - start;
+            }
+
+            benchSeed = 777u;
+            long settled = 0;
+            double start = nowSeconds();
+            for (int q = 0; q < queries; q++) {
+                int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+                destroyPathResult(aStarQuery(graph, ctx, from, to, (WeightMetric)m,
+                                             MODE_MASK_ALL));
+                settled += ctx->numSettled;
+            }
+            double elapsed = nowSeconds() - start;
+
+            printf("%-9s landmarks=%-3d build %8.1f ms %10.1f settled/query %10.2f us/query\n",
+                   metricNames[m], counts[c], build * 1e3, (double)settled / queries,
+                   elapsed * 1e6 / queries);
+        }
+        destroyLandmarks(graph->landmarks[m]);
+        graph->landmarks[m] = NULL;
+    }
+
+    destroyQueryContext(ctx);
+    destroyGraph(graph);
+}
+
+/**
+ * Mode-filtered dijkstraQuery: the allowed-mode mask costs one AND per edge
+ * and only shrinks the search. AdjNode keeps a one-byte mode id instead of
+ * a 20-byte name.
+ */
+static void benchModeFilter(void) {
+    const char* specs[] = {"all", "Train+Bus", "-Bus", "Train", "Bus"};
+    const int n = 20000;
+    const int queries = 200;
+
+    printf("\n--- Mode filter (%d-city geometric graph, %d time queries) ---\n", n, queries);
+    printf("AdjNode %zu bytes (48 with the mode name inline)\n", sizeof(AdjNode));
+    benchSeed = 31337u;
+    Graph* graph = buildGeometricGraph(n, 8.0);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    if (!graph || !ctx || !freezeGraph(graph)) {
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+        return;
+    }
+
+    for (int s = 0; s < (int)(sizeof(specs) / sizeof(specs[0])); s++) {
+        ModeMask modes;
+        if (!parseModeMask(graph, specs[s], &modes)) {
+            printf("modes %-9s not in this graph\n", specs[s]);
+            continue;
+        }
+
+        benchSeed = 999u;
+        long settled = 0;
+        int found = 0;
+        double start = nowSeconds();
+        for (int q = 0; q < queries; q++) {
+            int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+            PathResult* result = dijkstraQuery(graph, ctx, from, to, METRIC_TIME, modes);
+            settled += ctx->numSettled;
+            if (result) found++;
+            destroyPathResult(result);
+        }
+        double elapsed = nowSeconds() - start;
+        printf("modes %-9s %4d/%d found %10.1f settled/query %10.2f ms/query\n", specs[s],
+               found, queries, (double)settled / queries, elapsed * 1e3 / queries);
+    }
+
+    destroyQueryContext(ctx);
+    destroyGraph(graph);
+}
+
+/**
+ * Yen's k-shortest paths against a single dijkstraQuery on the same pairs
+ */
+static void benchKShortestPaths(void) {
+    const int ks[] = {1, 5, 10, 20};
+    const int n = 20000;
+    const int queries = 100;
+
+    printf("\n--- K-shortest paths (%d-city geometric graph, %d distance queries) ---\n",
+           n, queries);
+    benchSeed = 4711u;
+    Graph* graph = buildGeometricGraph(n, 8.0);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    QueryContext* tree = createQueryContext(graph ? graph->numCities : 0);
+    if (!graph || !ctx || !tree || !freezeGraph(graph)) {
+        destroyQueryContext(ctx);
+        destroyQueryContext(tree);
+        destroyGraph(graph);
+        return;
+    }
+
+    benchSeed = 2718u;
+    double start = nowSeconds();
+    for (int q = 0; q < queries; q++) {
+        int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+        destroyPathResult(dijkstraQuery(graph, ctx, from, to, METRIC_DISTANCE, MODE_MASK_ALL));
+    }
+    double dijkstraTime = (nowSeconds() - start) / queries;
+    printf("dijkstra       %10.2f ms/query\n", dijkstraTime * 1e3);
+
+    for (int i = 0; i < (int)(sizeof(ks) / sizeof(ks[0])); i++) {
+        benchSeed = 2718u;
+        long routes = 0, spurs = 0;
+        start = nowSeconds();
+        for (int q = 0; q < queries; q++) {
+            int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+            RankedPaths* paths = kShortestPathsQuery(graph, ctx, tree, from, to,
+                                                     METRIC_DISTANCE, ks[i]);
+            if (paths) {
+                routes += paths->numResults;
+                spurs += paths->numSpurSearches;
+            }
+            destroyRankedPaths(paths);
+        }
+        double elapsed = (nowSeconds() - start) / queries;
+        printf("yen k=%-3d      %10.2f ms/query (%.1fx dijkstra) %6.1f routes %8.1f spur searches\n",
+               ks[i], elapsed * 1e3, elapsed / dijkstraTime, (double)routes / queries,
+               (double)spurs / queries);
+    }
+
+    destroyQueryContext(ctx);
+    destroyQueryContext(tree);
+    destroyGraph(graph);
+}
+
+/**
+ * Queries sharing a few origins: dijkstraQuery every time against walks up
+ * cached shortest-path trees, with room for every origin and for a quarter
+ */
+static void benchTreeCache(void) {
+    const int n = 20000;
+    const int origins = 20;
+    const int queries = 2000;
+
+    printf("\n--- Shortest-path tree cache (%d-city geometric graph, %d queries from %d origins) ---\n",
+           n, queries, origins);
+    benchSeed = 4711u;
+    Graph* graph = buildGeometricGraph(n, 8.0);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    int* pairs = (int*)malloc(2 * queries * sizeof(int));
+    if (!graph || !ctx || !pairs || !freezeGraph(graph)) {
+        free(pairs);
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+        return;
+    }
+    benchSeed = 1618u;
+    for (int q = 0; q < queries; q++) {
+        pairs[2 * q] = (int)(nextRandom() % origins) * (n / origins);
+        pairs[2 * q + 1] = (int)(nextRandom() % n);
+    }
+
+    double start = nowSeconds();
+    long checksum = 0;
+    for (int q = 0; q < queries; q++) {
+        PathResult* result = dijkstraQuery(graph, ctx, pairs[2 * q], pairs[2 * q + 1],
+                                           METRIC_TIME, MODE_MASK_ALL);
+        if (result) checksum += result->pathLength;
+        destroyPathResult(result);
+    }
+    double elapsed = nowSeconds() - start;
+    printf("dijkstra            %10.2f us/query  (checksum %ld)\n", elapsed * 1e6 / queries,
+           checksum);
+
+    int capacities[] = {origins, origins / 4};
+    for (int c = 0; c < 2; c++) {
+        SPTCache* cache = createSPTCache(graph, capacities[c]);
+        if (!cache) break;
+        start = nowSeconds();
+        checksum = 0;
+        for (int q = 0; q < queries; q++) {
+            PathResult* result = sptCacheQuery(cache, ctx, pairs[2 * q], pairs[2 * q + 1],
+                                               METRIC_TIME);
+            if (result) checksum += result->pathLength;
+            destroyPathResult(result);
+        }
+        elapsed = nowSeconds() - start;
+
+        SPTCacheStats stats;
+        getSPTCacheStats(cache, &stats);
+        printf("tree cache %3d      %10.2f us/query  (checksum %ld) hits %lu misses %lu evictions %lu\n",
+               capacities[c], elapsed * 1e6 / queries, checksum, stats.hits, stats.misses,
+               stats.evictions);
+        destroySPTCache(cache);
+    }
+
+    free(pairs);
+    destroyQueryContext(ctx);
+    destroyGraph(graph);
+}
+
+/**
+ * Random delays and speed-ups on a graph with 20 cached trees: rebuilding
+ * every tree after each change against sptCacheUpdateRoute, which only
+ * re-settles the cities whose distance moved
+ */
+static void benchRouteUpdates(void) {
+    const int n = 20000;
+    const int origins = 20;
+    const int rebuilds = 10;
+    const int updates = 5000;
+
+    printf("\n--- Route updates (%d-city geometric graph, %d cached time trees) ---\n", n, origins);
+    benchSeed = 4711u;
+    Graph* graph = buildGeometricGraph(n, 8.0);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    SPTCache* cache = graph ? createSPTCache(graph, origins) : NULL;
+    const CSRGraph* csr = graph ? freezeGraph(graph) : NULL;
+    if (!graph || !ctx || !cache || !csr) {
+        destroySPTCache(cache);
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+        return;
+    }
+    for (int o = 0; o < origins; o++) {
+        sptCacheDistance(cache, ctx, o * (n / origins), 0, METRIC_TIME);
+    }
+
+    benchSeed = 2718u;
+    double start = nowSeconds();
+    for (int u = 0; u < updates; u++) {
+        bool rebuild = u < rebuilds;
+        int from = (int)(nextRandom() % n);
+        int degree = csr->offsets[from + 1] - csr->offsets[from];
+        if (degree == 0) continue;
+        int e = csr->offsets[from] + (int)(nextRandom() % degree);
+        double time = csr->time[e] * (0.5 + (nextRandom() % 1000) / 1000.0);
+        const char* fromId = graph->cities[from].id;
+        const char* toId = graph->cities[csr->target[e]].id;
+        const char* mode = graph->modeNames[csr->modeId[e]];
+        if (rebuild) {
+            // Plain update: the next lookups drop and rebuild every tree
+            updateRoute(graph, fromId, toId, mode, csr->distance[e], time, csr->cost[e]);
+            for (int o = 0; o < origins; o++) {
+                sptCacheDistance(cache, ctx, o * (n / origins), 0, METRIC_TIME);
+            }
+            if (u == rebuilds - 1) {
+                double elapsed = nowSeconds() - start;
+                printf("update + rebuild    %10.2f us/update\n", elapsed * 1e6 / rebuilds);
+                start = nowSeconds();
+            }
+        } else {
+            sptCacheUpdateRoute(cache, ctx, fromId, toId, mode, csr->distance[e], time,
+                                csr->cost[e]);
+        }
+    }
+    double elapsed = nowSeconds() - start;
+
+    SPTCacheStats stats;
+    getSPTCacheStats(cache, &stats);
+    long cached = 0, fresh = 0;
+    for (int o = 0; o < origins; o++) {
+        int target = (o * 7919) % n;
+        cached += sptCacheDistance(cache, ctx, o * (n / origins), target, METRIC_TIME);
+        PathResult* result = dijkstraQuery(graph, ctx, o * (n / origins), target, METRIC_TIME,
+                                           MODE_MASK_ALL);
+        if (result) fresh += queryDistance(ctx, target);
+        destroyPathResult(result);
+    }
+    printf("repair              %10.2f us/update  (%.0f updates/s, %.1f cities re-settled per tree)\n",
+           elapsed * 1e6 / (updates - rebuilds), (updates - rebuilds) / elapsed,
+           (double)stats.repairedCities / ((double)(updates - rebuilds) * origins));
+    printf("checksum cached %ld, fresh dijkstra %ld\n", cached, fresh);
+
+    destroySPTCache(cache);
+    destroyQueryContext(ctx);
+    destroyGraph(graph);
+}
+
+/**
+ * Seconds per deltaSteppingQuery from each of `sources` spread-out cities;
+ * adds every reached distance to checksum
+ */
+static double timeDeltaStepping(Graph* graph, int sources, int delta, int threads,
+                                long* checksum, int* phases) {
+    int n = graph->numCities;
+    double start = nowSeconds();
+    for (int s = 0; s < sources; s++) {
+        ShortestPathTree* tree = deltaSteppingQuery(graph, s * (n / sources), METRIC_TIME, delta,
+                                                    threads);
+        if (!tree) return 0;
+        for (int city = 0; city < n; city++) {
+            if (tree->dist[city] != INFINITY_DIST) *checksum += tree->dist[city];
+        }
+        *phases = tree->numPhases;
+        destroyShortestPathTree(tree);
+    }
+    return (nowSeconds() - start) / sources;
+}
+
+/**
+ * One-to-all search on a graph with about two million edges:
+ * dijkstraOneToAll against deltaSteppingQuery over bucket widths on one
+ * thread, then 1, 2, 4, ... threads up to one per core
+ */
+static void benchDeltaStepping(void) {
+    const int n = 250000;
+    const int sources = 3;
+
+    benchSeed = 8086u;
+    Graph* graph = buildGeometricGraph(n, 8.0);
+    QueryContext* ctx = createQueryContext(graph ? graph->numCities : 0);
+    const CSRGraph* csr = graph ? freezeGraph(graph) : NULL;
+    if (!graph || !ctx || !csr) {
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+        return;
+    }
+    int cores = getDefaultThreadCount();
+    printf("\n--- Delta-stepping (%d-city geometric graph, %d edges, time, %d cores) ---\n",
+           n, csr->numEdges, cores);
+
+    double start = nowSeconds();
+    long checksum = 0;
+    for (int s = 0; s < sources; s++) {
+        dijkstraOneToAll(graph, ctx, s * (n / sources), METRIC_TIME, false);
+        for (int city = 0; city < n; city++) {
+            int dist = queryDistance(ctx, city);
+            if (dist != INFINITY_DIST) checksum += dist;
+        }
+    }
+    double baseline = (nowSeconds() - start) / sources;
+    printf("dijkstraOneToAll            %10.2f ms/source  (checksum %ld)\n", baseline * 1e3,
+           checksum);
+
+    int mean = defaultDeltaWidth(csr, METRIC_TIME);
+    int widths[] = {mean / 4 > 0 ? mean / 4 : 1, mean, 4 * mean};
+    for (int w = 0; w < 3; w++) {
+        checksum = 0;
+        int phases = 0;
+        double elapsed = timeDeltaStepping(graph, sources, widths[w], 1, &checksum, &phases);
+        printf("delta=%-6d threads=1     %10.2f ms/source  (checksum %ld) %d light rounds\n",
+               widths[w], elapsed * 1e3, checksum, phases);
+    }
+
+    // 1, 2, 4, ... and finally exactly one thread per core, default width
+    double single = 0;
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > cores) threads = cores;
+        checksum = 0;
+        int phases = 0;
+        double elapsed = timeDeltaStepping(graph, sources, 0, threads, &checksum, &phases);
+        if (threads == 1) single = elapsed;
+        printf("delta=%-6d threads=%-5d %10.2f ms/source  (checksum %ld) speedup %5.2fx\n",
+               mean, threads, elapsed * 1e3, checksum, single / elapsed);
+        if (threads == cores) break;
+    }
+
+    destroyQueryContext(ctx);
+    destroyGraph(graph);
+}
+
+/**
+ * Many-to-many weights: N x M dijkstra() calls against distanceMatrixQuery
+ */
+static void benchDistanceMatrix(void) {
+    const int side = 100;
+    const int count = 50;
+
+    printf("\n--- Distance matrix (%dx%d grid, %d x %d) ---\n", side, side, count, count);
+    Graph* graph = buildGridGraph(side);
+    int* sources = (int*)malloc(count * sizeof(int));
+    int* targets = (int*)malloc(count * sizeof(int));
+    if (!graph || !sources || !targets || !freezeGraph(graph)) {
+        free(sources);
+        free(targets);
+        destroyGraph(graph);
+        return;
+    }
+    int n = graph->numCities;
+    benchSeed = 4242u;
+    for (int i = 0; i < count; i++) {
+        sources[i] = (int)(nextRandom() % n);
+        targets[i] = (int)(nextRandom() % n);
+    }
+
+    double start = nowSeconds();
+    long checksum = 0;
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < count; j++) {
+            PathResult* result = dijkstra(graph, graph->cities[sources[i]].id,
+                                          graph->cities[targets[j]].id, "distance");
+            if (result) checksum += result->totalDistance;
+            destroyPathResult(result);
+        }
+    }
+    printf("naive dijkstra loop  %10.2f ms  (checksum %ld)\n", (nowSeconds() - start) * 1e3,
+           checksum);
+
+    int threadCounts[] = {1, getDefaultThreadCount()};
+    for (int t = 0; t < 2; t++) {
+        if (t == 1 && threadCounts[1] == 1) break;
+        start = nowSeconds();
+        DistanceMatrix* matrix = distanceMatrixQuery(graph, sources, count, targets, count,
+                                                     METRIC_DISTANCE, threadCounts[t]);
+        double elapsed = nowSeconds() - start;
+        checksum = 0;
+        for (int i = 0; matrix && i < count * count; i++) {
+            if (matrix->values[i] != INFINITY_DIST) checksum += matrix->values[i];
+        }
+        printf("distanceMatrix x%-3d  %10.2f ms  (checksum %ld)\n", threadCounts[t],
+               elapsed * 1e3, checksum);
+        destroyDistanceMatrix(matrix);
+    }
+
+    free(sources);
+    free(targets);
+    destroyGraph(graph);
+}
+
+/**
+ * Pareto search: whole trade-off set per query against one Dijkstra per
+ * criterion, which only finds its three extremes
+ */
+static void benchPareto(void) {
+    const int sizes[] = {1000, 2000, 4000};
+    const int queries = 20;
+
+    printf("\n--- Pareto routes (geometric graphs, %d queries) ---\n", queries);
+    printf("%8s %12s %12s %10s %12s\n", "cities", "3x dijkstra", "pareto", "routes", "labels");
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        benchSeed = 2718u;
+        Graph* graph = buildGeometricGraph(sizes[s], 6.0);
+        QueryContext* ctx = graph && freezeGraph(graph) ? createQueryContext(graph->numCities) : NULL;
+        if (!ctx) {
+            destroyGraph(graph);
+            return;
+        }
+
+        double dijkstraTime = 0, paretoTime = 0;
+        long routes = 0, labels = 0;
+        for (int q = 0; q < queries; q++) {
+            int from = (int)(nextRandom() % sizes[s]), to = (int)(nextRandom() % sizes[s]);
+            double start = nowSeconds();
+            for (int m = 0; m < METRIC_COUNT; m++) {
+                destroyPathResult(dijkstraQuery(graph, ctx, from, to, (WeightMetric)m,
+                                                MODE_MASK_ALL));
+            }
+            dijkstraTime += nowSeconds() - start;
+
+            start = nowSeconds();
+            ParetoSet* set = paretoQuery(graph, ctx, from, to, 0);
+            paretoTime += nowSeconds() - start;
+            if (set) {
+                routes += set->numResults;
+                labels += set->numLabels;
+            }
+            destroyParetoSet(set);
+        }
+        printf("%8d %9.2f ms %9.2f ms %10.1f %12.0f\n", sizes[s], dijkstraTime * 1e3 / queries,
+               paretoTime * 1e3 / queries, (double)routes / queries, (double)labels / queries);
+
+        destroyQueryContext(ctx);
+        destroyGraph(graph);
+    }
+}
+
+/**
+ * Connection Scan on two days of regular services over a geometric graph:
+ * earliest arrival from a random morning time, and a 3-hour departure profile
+ */
+static void benchTimetable(void) {
+    const int numCities = 10000;
+    const int queries = 50;
+
+    benchSeed = 1618u;
+    Graph* graph = buildGeometricGraph(numCities, 6.0);
+    double start = nowSeconds();
+    Timetable* timetable = graph ? buildTimetableFromRoutes(graph, 0, 2 * MINUTES_PER_DAY) : NULL;
+    if (!timetable) {
+        destroyGraph(graph);
+        return;
+    }
+    Journey* warmup = earliestArrival(timetable, 0, 1, 0);   // sorts the connections
+    double buildTime = nowSeconds() - start;
+    destroyJourney(warmup);
+
+    printf("\n--- Connection Scan (%d cities, %d connections, %d queries) ---\n", numCities,
+           timetable->numConnections, queries);
+    printf("build + sort          %10.2f ms\n", buildTime * 1e3);
+
+    double earliestTime = 0, profileTime = 0;
+    long reached = 0, options = 0;
+    for (int q = 0; q < queries; q++) {
+        // Destination a 10-hop random walk away, so most journeys fit in the timetable
+        const CSRGraph* csr = graph->frozen;
+        int from = (int)(nextRandom() % numCities), to = from;
+        for (int hop = 0; hop < 10 && csr->offsets[to + 1] > csr->offsets[to]; hop++) {
+            int degree = csr->offsets[to + 1] - csr->offsets[to];
+            to = csr->target[csr->offsets[to] + (int)(nextRandom() % degree)];
+        }
+        int departAfter = 6 * 60 + (int)(nextRandom() % (6 * 60));
+
+        start = nowSeconds();
+        Journey* journey = earliestArrival(timetable, from, to, departAfter);
+        earliestTime += nowSeconds() - start;
+        if (journey) reached++;
+        destroyJourney(journey);
+
+        start = nowSeconds();
+        Profile* profile = profileQuery(timetable, from, to, departAfter, departAfter + 180);
+        profileTime += nowSeconds() - start;
+        if (profile) options += profile->numEntries;
+        destroyProfile(profile);
+    }
+    printf("earliest arrival      %10.3f ms/query  (%ld of %d reached)\n",
+           earliestTime * 1e3 / queries, reached, queries);
+    printf("profile, 3h window    %10.3f ms/query  (%.1f departures each)\n",
+           profileTime * 1e3 / queries, (double)options / queries);
+
+    destroyTimetable(timetable);
+    destroyGraph(graph);
+}
+
+/**
+ * Batch throughput of the worker pool from 1 thread up to one per core
+ */
+static void benchQueryPool(void) {
+    const int side = 100;
+    const int numQueries = 2000;
+
+    Graph* graph = buildGridGraph(side);
+    BatchQuery* queries = (BatchQuery*)malloc(numQueries * sizeof(BatchQuery));
+    PathResult** results = (PathResult**)malloc(numQueries * sizeof(PathResult*));
+    if (!graph || !queries || !results) {
+        free(queries);
+        free(results);
+        destroyGraph(graph);
+        return;
+    }
+    int n = graph->numCities;
+    benchSeed = 2024u;
+    for (int i = 0; i < numQueries; i++) {
+        queries[i].start = (int)(nextRandom() % n);
+        queries[i].end = (int)(nextRandom() % n);
+        queries[i].algorithm = ALGORITHM_DIJKSTRA;
+        queries[i].metric = METRIC_DISTANCE;
+        queries[i].modes = MODE_MASK_ALL;
+    }
+
+    int cores = getDefaultThreadCount();
+    printf("\n--- Batch query pool (%dx%d grid, %d dijkstra queries, %d cores) ---\n",
+           side, side, numQueries, cores);
+    double baseline = 0;
+    // 1, 2, 4, ... and finally exactly one thread per core
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > cores) threads = cores;
+        QueryPool* pool = createQueryPool(graph, threads);
+        if (!pool) break;
+        double start = nowSeconds();
+        runBatch(pool, queries, numQueries, results);
+        double elapsed = nowSeconds() - start;
+        for (int i = 0; i < numQueries; i++) {
+            destroyPathResult(results[i]);
+        }
+        destroyQueryPool(pool);
+
+        double qps = numQueries / elapsed;
+        if (threads == 1) baseline = qps;
+        printf("threads=%-3d %12.0f queries/s  speedup %5.2fx\n", threads, qps, qps / baseline);
+        if (threads == cores) break;
+    }
+
+    free(queries);
+    free(results);
+    destroyGraph(graph);
+}
+
+/**
+ * Contraction hierarchy preprocessing cost and query latency against
+ * plain Dijkstra on grids, one hierarchy per metric
+ */
+static void benchContractionHierarchies(void) {
+    const int sides[] = {32, 100};
+    const char* metricNames[] = {"distance", "time", "cost"};
+    const int queries = 200;
+
+    printf("\n--- Contraction hierarchies ---\n");
+    for (int s = 0; s < (int)(sizeof(sides) / sizeof(sides[0])); s++) {
+        Graph* graph = buildGridGraph(sides[s]);
+        if (!graph) return;
+        int n = graph->numCities;
+        QueryContext* forward = createQueryContext(n);
+        QueryContext* backward = createQueryContext(n);
+
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            double start = nowSeconds();
+            ContractionHierarchy* ch = buildContractionHierarchy(graph, (WeightMetric)m);
+            double buildTime = nowSeconds() - start;
+            if (!ch) break;
+
+            double dijkstraTime = 0, chTime = 0;
+            long dijkstraSettled = 0, chSettled = 0;
+            int mismatches = 0;
+            for (int q = 0; q < queries; q++) {
+                int from = (int)(nextRandom() % n), to = (int)(nextRandom() % n);
+
+                start = nowSeconds();
+                PathResult* expected = dijkstraQuery(graph, forward, from, to, (WeightMetric)m,
+                                                     MODE_MASK_ALL);
+                dijkstraTime += nowSeconds() - start;
+                dijkstraSettled += forward->numSettled;
+
+                start = nowSeconds();
+                PathResult* actual = chQuery(graph, ch, forward, backward, from, to);
+                chTime += nowSeconds() - start;
+                chSettled += forward->numSettled + backward->numSettled;
+
+                if (expected && actual && m != METRIC_TIME) {
+                    int a = m == METRIC_COST ? expected->totalCost : expected->totalDistance;
+                    int b = m == METRIC_COST ? actual->totalCost : actual->totalDistance;
+                    mismatches += a != b;
+                }
+                destroyPathResult(expected);
+                destroyPathResult(actual);
+            }
+
+            printf("%8d cities %-8s  build %8.1f ms  %7d shortcuts  %8.2f MB  "
+                   "query %8.2f us (%6.0f settled) vs dijkstra %9.2f us (%8.0f)%s\n",
+                   n, metricNames[m], buildTime * 1e3, ch->numShortcuts,
+                   getHierarchyMemoryBytes(ch) / (1024.0 * 1024.0),
+                   chTime * 1e6 / queries, (double)chSettled / queries,
+                   dijkstraTime * 1e6 / queries, (double)dijkstraSettled / queries,
+                   mismatches ? "  MISMATCH" : "");
+            destroyContractionHierarchy(ch);
+        }
+
+        destroyQueryContext(forward);
+        destroyQueryContext(backward);
+        destroyGraph(graph);
+    }
+}
+
+/**
+ * Allocation counts for building and tearing down a graph: one malloc per
+ * adjacency node before the edge arena, one per arena block now
+ */
+static void benchAllocations(void) {
+    const int side = 316;
+
+    printf("\n--- Allocations (%dx%d grid) ---\n", side, side);
+    double start = nowSeconds();
+    Graph* graph = buildGridGraph(side);
+    if (!graph) return;
+    double buildTime = nowSeconds() - start;
+
+    long adjNodes = graph->isDirected ? graph->numRoutes : 2L * graph->numRoutes;
+    const Arena* arena = &graph->edgeArena;
+    printf("adjacency nodes %ld: per-node malloc %ld allocs / %zu bytes requested\n",
+           adjNodes, adjNodes, (size_t)adjNodes * sizeof(AdjNode));
+    printf("edge arena: %d allocs / %zu bytes reserved (%zu used)\n",
+           arena->numBlocks, arena->bytesReserved, arena->bytesUsed);
+    // Per query: dist, parent, visited and the heap's struct + two arrays
+    // before; one search slab now (PathResult and its path in both cases)
+    printf("dijkstra per query: 6 + 2 allocs before, 1 + 2 allocs now\n");
+
+    start = nowSeconds();
+    destroyGraph(graph);
+    printf("build %.2f ms  teardown %.2f ms\n", buildTime * 1e3,
+           (nowSeconds() - start) * 1e3);
+}
+
+/**
+ * Pre-hash findCityIndex, kept here only as a baseline
+ */
+static int linearFindCity(Graph* graph, const char* id) {
+    for (int i = 0; i < graph->numCities; i++) {
+        if (strcmp(graph->cities[i].id, id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Load 100k cities and 1M random routes, and compare the id lookups the
+ * load performs against the cost the old linear scan would have had
+ */
+static void benchGraphLoad(void) {
+    const int numCities = 100000;
+    const int numRoutes = 1000000;
+    const int samples = 200;
+    char id[16], from[16], to[16];
+
+    printf("\n--- Graph load (%d cities, %d routes) ---\n", numCities, numRoutes);
+
+    double start = nowSeconds();
+    Graph* graph = createGraph(false);
+    if (!graph) return;
+    for (int i = 0; i < numCities; i++) {
+        snprintf(id, sizeof(id), "c%d", i);
+        addCity(graph, id, id, 8.0 + (nextRandom() % 2900) / 100.0,
+                68.0 + (nextRandom() % 2900) / 100.0);
+    }
+    for (int r = 0; r < numRoutes; r++) {
+        snprintf(from, sizeof(from), "c%u", nextRandom() % numCities);
+        snprintf(to, sizeof(to), "c%u", nextRandom() % numCities);
+        int distance = 10 + (int)(nextRandom() % 500);
+        addRoute(graph, from, to, distance, distance / 60.0, distance * 2, "Train");
+    }
+    double loadTime = nowSeconds() - start;
+
+    // One lookup per addCity plus two per addRoute
+    double lookups = numCities + 2.0 * numRoutes;
+
+    start = nowSeconds();
+    long found = 0;
+    for (int s = 0; s < samples; s++) {
+        snprintf(id, sizeof(id), "c%u", nextRandom() % numCities);
+        found += linearFindCity(graph, id) >= 0;
+    }
+    double linearPerLookup = (nowSeconds() - start) / samples;
+
+    start = nowSeconds();
+    for (int s = 0; s < samples * 1000; s++) {
+        snprintf(id, sizeof(id), "c%u", nextRandom() % numCities);
+        found += findCityIndex(graph, id) >= 0;
+    }
+    double hashPerLookup = (nowSeconds() - start) / (samples * 1000);
+
+    double linearLoad = loadTime + lookups * (linearPerLookup - hashPerLookup);
+    printf("hash load %.2f s   lookup %.1f ns hash vs %.1f us linear (found %ld)\n",
+           loadTime, hashPerLookup * 1e9, linearPerLookup * 1e6, found);
+    printf("estimated linear-scan load %.0f s   speedup %.0fx\n",
+           linearLoad, linearLoad / loadTime);
+
+    destroyGraph(graph);
+}
+
+/**
+ * Startup cost: building a large graph with addCity/addRoute against
+ * mapping the same graph from a binary file
+ */
+static void benchGraphFile(void) {
+    const int numCities = 500000;
+    const char* path = "bench_graph.bin";
+
+    printf("\n--- Binary graph file (%d-city geometric graph) ---\n", numCities);
+    benchSeed = 31337u;
+    double start = nowSeconds();
+    Graph* built = buildGeometricGraph(numCities, 6.0);
+    if (!built || !freezeGraph(built)) {
+        destroyGraph(built);
+        return;
+    }
+    double buildTime = nowSeconds() - start;
+
+    start = nowSeconds();
+    bool saved = saveGraphBinary(built, path);
+    double saveTime = nowSeconds() - start;
+
+    start = nowSeconds();
+    Graph* mapped = saved ? loadGraphBinary(path) : NULL;
+    double loadTime = nowSeconds() - start;
+    if (!mapped) {
+        destroyGraph(built);
+        remove(path);
+        return;
+    }
+
+    // Same answers from both graphs; the first mapped query pays the page faults
+    QueryContext* ctx = createQueryContext(numCities);
+    long builtSum = 0, mappedSum = 0;
+    double firstQuery = 0;
+    benchSeed = 7u;
+    for (int q = 0; ctx && q < 20; q++) {
+        int from = (int)(nextRandom() % numCities), to = (int)(nextRandom() % numCities);
+        PathResult* result = dijkstraQuery(built, ctx, from, to, METRIC_DISTANCE, MODE_MASK_ALL);
+        if (result) builtSum += result->totalDistance;
+        destroyPathResult(result);
+
+        start = nowSeconds();
+        result = dijkstraQuery(mapped, ctx, from, to, METRIC_DISTANCE, MODE_MASK_ALL);
+        if (q == 0) firstQuery = nowSeconds() - start;
+        if (result) mappedSum += result->totalDistance;
+        destroyPathResult(result);
+    }
+
+    printf("edges %d   file %.1f MB\n", built->frozen->numEdges, mapped->mappingSize / 1e6);
+    printf("build with addRoute + freeze %8.1f ms\n", buildTime * 1e3);
+    printf("save                         %8.1f ms\n", saveTime * 1e3);
+    printf("mmap load                    %8.3f ms   first query %.1f ms\n",
+           loadTime * 1e3, firstQuery * 1e3);
+    printf("checksum built %ld mapped %ld\n", builtSum, mappedSum);
+
+    destroyQueryContext(ctx);
+    destroyGraph(mapped);
+    destroyGraph(built);
+    remove(path);
+}
+
+/**
+ * Writes cities.csv/routes.csv with random routes between random cities
+ */
+static bool writeBenchCSV(const char* citiesPath, const char* routesPath, int numCities,
+                          int numRoutes) {
+    static const char* modes[] = {"Train", "Bus", "Flight"};
+    FILE* cities = fopen(citiesPath, "w");
+    FILE* routes = fopen(routesPath, "w");
+    if (!cities || !routes) {
+        if (cities) fclose(cities);
+        if (routes) fclose(routes);
+        return false;
+    }
+
+    fprintf(cities, "id,name,lat,lon\n");
+    for (int i = 0; i < numCities; i++) {
+        fprintf(cities, "c%d,City %d,%.4f,%.4f\n", i, i,
+                8.0 + (nextRandom() % 270000) / 10000.0, 68.0 + (nextRandom() % 290000) / 10000.0);
+    }
+    fprintf(routes, "from,to,distance,time,cost,mode\n");
+    for (int r = 0; r < numRoutes; r++) {
+        int distance = 10 + (int)(nextRandom() % 1500);
+        fprintf(routes, "c%u,c%u,%d,%.2f,%d,%s\n", nextRandom() % numCities,
+                nextRandom() % numCities, distance, distance / 60.0, distance * 2, modes[r % 3]);
+    }
+    fclose(cities);
+    return fclose(routes) == 0;
+}
+
+/**
+ * Row-at-a-time baseline: fgets + strtok + addRoute per row, then freeze
+ */
+static Graph* loadCSVPerRow(const char* citiesPath, const char* routesPath) {
+    FILE* cities = fopen(citiesPath, "r");
+    FILE* routes = fopen(routesPath, "r");
+    Graph* graph = createGraph(false);
+    char line[256];
+
+    while (cities && routes && graph && fgets(line, sizeof(line), cities)) {
+        char* id = strtok(line, ",");
+        char* name = strtok(NULL, ",");
+        char* lat = strtok(NULL, ",");
+        char* lon = strtok(NULL, ",\r\n");
+        if (lon) addCity(graph, id, name, atof(lat), atof(lon));
+    }
+    while (cities && routes && graph && fgets(line, sizeof(line), routes)) {
+        char* from = strtok(line, ",");
+        char* to = strtok(NULL, ",");
+        char* distance = strtok(NULL, ",");
+        char* time = strtok(NULL, ",");
+        char* cost = strtok(NULL, ",");
+        char* mode = strtok(NULL, ",\r\n");
+        if (mode) addRoute(graph, from, to, atoi(distance), atof(time), atoi(cost), mode);
+    }
+    if (cities) fclose(cities);
+    if (routes) fclose(routes);
+    if (graph) freezeGraph(graph);
+    return graph;
+}
+
+/**
+ * CSV import: per-row addRoute against the streaming two-pass bulk loader
+ */
+static void benchCSVLoad(void) {
+    const int numCities = 100000, numRoutes = 2000000;
+    const char* citiesPath = "bench_cities.csv";
+    const char* routesPath = "bench_routes.csv";
+
+    printf("\n--- CSV loading (%d cities, %d routes) ---\n", numCities, numRoutes);
+    benchSeed = 4242u;
+    if (!writeBenchCSV(citiesPath, routesPath, numCities, numRoutes)) {
+        printf("cannot write %s\n", routesPath);
+        remove(citiesPath);
+        remove(routesPath);
+        return;
+    }
+
+    double start = nowSeconds();
+    Graph* perRow = loadCSVPerRow(citiesPath, routesPath);
+    double perRowTime = nowSeconds() - start;
+    printf("fgets + addRoute + freeze    %8.1f ms   edges %d\n", perRowTime * 1e3,
+           perRow && perRow->frozen ? perRow->frozen->numEdges : 0);
+    destroyGraph(perRow);
+
+    int threadCounts[] = {1, getDefaultThreadCount()};
+    for (int i = 0; i < (threadCounts[1] > 1 ? 2 : 1); i++) {
+        CSVLoadStats stats;
+        start = nowSeconds();
+        Graph* bulk = loadGraphCSV(citiesPath, routesPath, false, threadCounts[i], &stats);
+        double bulkTime = nowSeconds() - start;
+        printf("loadGraphCSV, %2d thread(s)  %8.1f ms   edges %d   skipped %ld   %.2fx\n",
+               threadCounts[i], bulkTime * 1e3, bulk ? bulk->frozen->numEdges : 0,
+               stats.routesSkipped, perRowTime / bulkTime);
+        destroyGraph(bulk);
+    }
+
+    remove(citiesPath);
+    remove(routesPath);
+}
+
+/**
+ * Dijkstra-shaped heap workload: every node is pushed, decreased a few
+ * times and popped, with pops interleaved the way a search settles nodes
+ */
+static void benchHeapScaling(void) {
+    const int sizes[] = {20, 1000, 10000, 100000, 1000000};
+    const int decreasesPerNode = 3;
+
+    printf("\n--- Priority queue scaling (%d decrease-keys per node) ---\n",
+           decreasesPerNode);
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int n = sizes[s];
+        MinHeap* heap = createMinHeap(n);
+        if (!heap) return;
+
+        double start = nowSeconds();
+        long operations = 0;
+        int base = 0;
+        for (int city = 0; city < n; city++) {
+            int priority = base + (int)(nextRandom() % 100000);
+            heapPushOrDecrease(heap, city, priority);
+            operations++;
+            for (int d = 0; d < decreasesPerNode; d++) {
+                priority -= (int)(nextRandom() % 1000);
+                if (priority < base) priority = base;
+                heapPushOrDecrease(heap, city, priority);
+                operations++;
+            }
+            if (city % 2 == 1) {
+                base = heapMinPriority(heap);
+                heapPopMin(heap);
+                operations++;
+            }
+        }
+        while (!heapIsEmpty(heap)) {
+            heapPopMin(heap);
+            operations++;
+        }
+        double elapsed = nowSeconds() - start;
+
+        printf("%8d nodes  %10ld ops  %8.3f ms  %6.1f ns/op\n",
+               n, operations, elapsed * 1e3, elapsed * 1e9 / operations);
+        destroyMinHeap(heap);
+    }
+}
+
+// Engines timed by `bench suite`
+typedef enum {
+    ENGINE_DIJKSTRA,
+    ENGINE_BIDIRECTIONAL,
+    ENGINE_ASTAR,
+    ENGINE_ALT,
+    ENGINE_CH,
+    ENGINE_BFS,
+    ENGINE_DFS,
+    ENGINE_COUNT
+} SuiteEngine;
+
+static const char* engineNames[ENGINE_COUNT] = {
+    "dijkstra", "bidirectional", "astar", "alt", "ch", "bfs", "dfs"
+};
+
+typedef struct {
+    const char* graphKind;    // grid | geometric | scalefree | all
+    int nodes;
+    int queries;
+    WeightMetric metric;
+    bool json;
+    bool skipCH;
+    unsigned int seed;
+} SuiteOptions;
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+static double percentile(const double* sorted, int count, double fraction) {
+    return count > 0 ? sorted[(int)(fraction * (count - 1) + 0.5)] : 0;
+}
+
+/**
+ * One machine-readable result row (CSV or JSON lines)
+ */
+static void printSuiteRow(const SuiteOptions* options, const char* graphName, const Graph* graph,
+                          SuiteEngine engine, double* latencies, int found, long settled,
+                          double preprocessSeconds) {
+    static const char* metricNames[METRIC_COUNT] = {"distance", "time", "cost"};
+    int q = options->queries;
+    double total = 0;
+    for (int i = 0; i < q; i++) {
+        total += latencies[i];
+    }
+    qsort(latencies, q, sizeof(double), compareDoubles);
+
+    double p50 = percentile(latencies, q, 0.50) * 1e6;
+    double p90 = percentile(latencies, q, 0.90) * 1e6;
+    double p99 = percentile(latencies, q, 0.99) * 1e6;
+    double mean = q > 0 ? total * 1e6 / q : 0;
+    double meanSettled = q > 0 ? (double)settled / q : 0;
+    double qps = total > 0 ? q / total : 0;
+
+    if (options->json) {
+        printf("{\"graph\":\"%s\",\"nodes\":%d,\"edges\":%d,\"engine\":\"%s\",\"metric\":\"%s\","
+               "\"queries\":%d,\"found\":%d,\"p50_us\":%.2f,\"p90_us\":%.2f,\"p99_us\":%.2f,"
+               "\"mean_us\":%.2f,\"mean_settled\":%.1f,\"qps\":%.0f,\"preprocess_ms\":%.1f}\n",
+               graphName, graph->numCities, graph->numRoutes, engineNames[engine],
+               metricNames[options->metric], q, found, p50, p90, p99, mean, meanSettled, qps,
+               preprocessSeconds * 1e3);
+    } else {
+        printf("%s,%d,%d,%s,%s,%d,%d,%.2f,%.2f,%.2f,%.2f,%.1f,%.0f,%.1f\n",
+               graphName, graph->numCities, graph->numRoutes, engineNames[engine],
+               metricNames[options->metric], q, found, p50, p90, p99, mean, meanSettled, qps,
+               preprocessSeconds * 1e3);
+    }
+}
+
+/**
+ * Time every engine over the same fixed random query set on one graph
+ */
+static void runSuiteOnGraph(const SuiteOptions* options, const char* graphName, Graph* graph) {
+    int n = graph->numCities;
+    int q = options->queries;
+    QueryContext* forward = createQueryContext(n);
+    QueryContext* backward = createQueryContext(n);
+    int* pairs = (int*)malloc(2 * (size_t)q * sizeof(int));
+    double* latencies = (double*)malloc((q > 0 ? q : 1) * sizeof(double));
+    if (n == 0 || !forward || !backward || !pairs || !latencies || !freezeGraph(graph)) {
+        destroyQueryContext(forward);
+        destroyQueryContext(backward);
+        free(pairs);
+        free(latencies);
+        return;
+    }
+
+    benchSeed = options->seed;
+    for (int i = 0; i < 2 * q; i++) {
+        pairs[i] = (int)(nextRandom() % n);
+    }
+
+    WeightMetric metric = options->metric;
+    for (int engine = 0; engine < ENGINE_COUNT; engine++) {
+        double preprocess = 0;
+        ContractionHierarchy* ch = NULL;
+        if (engine == ENGINE_CH) {
+            if (options->skipCH) continue;
+            double start = nowSeconds();
+            ch = buildContractionHierarchy(graph, metric);
+            preprocess = nowSeconds() - start;
+            if (!ch) continue;
+        } else if (engine == ENGINE_ALT) {
+            double start = nowSeconds();
+            if (!prepareLandmarks(graph, metric, ALT_DEFAULT_LANDMARKS)) continue;
+            preprocess = nowSeconds() - start;
+        }
+
+        int found = 0;
+        long settled = 0;
+        for (int i = 0; i < q; i++) {
+            int from = pairs[2 * i], to = pairs[2 * i + 1];
+            PathResult* result = NULL;
+
+            double start = nowSeconds();
+            switch ((SuiteEngine)engine) {
+                case ENGINE_DIJKSTRA:
+                    result = dijkstraQuery(graph, forward, from, to, metric, MODE_MASK_ALL);
+                    break;
+                case ENGINE_BIDIRECTIONAL:
+                    result = bidirectionalDijkstraQuery(graph, forward, backward, from, to, metric,
+                                                        MODE_MASK_ALL);
+                    break;
+                case ENGINE_ASTAR:
+                case ENGINE_ALT:
+                    result = aStarQuery(graph, forward, from, to, metric, MODE_MASK_ALL);
+                    break;
+                case ENGINE_CH:
+                    result = chQuery(graph, ch, forward, backward, from, to);
+                    break;
+                case ENGINE_BFS:
+                    result = bfsQuery(graph, forward, from, to, MODE_MASK_ALL);
+                    break;
+                case ENGINE_DFS:
+                    result = dfsQuery(graph, forward, from, to, MODE_MASK_ALL);
+                    break;
+                default:
+                    break;
+            }
+            latencies[i] = nowSeconds() - start;
+
+            bool twoSided = engine == ENGINE_BIDIRECTIONAL || engine == ENGINE_CH;
+            settled += forward->numSettled + (twoSided ? backward->numSettled : 0);
+            if (result) found++;
+            destroyPathResult(result);
+        }
+
+        printSuiteRow(options, graphName, graph, (SuiteEngine)engine, latencies, found, settled,
+                      preprocess);
+
+        destroyContractionHierarchy(ch);
+        if (engine == ENGINE_ALT) {
+            destroyLandmarks(graph->landmarks[metric]);
+            graph->landmarks[metric] = NULL;
+        }
+    }
+
+    destroyQueryContext(forward);
+    destroyQueryContext(backward);
+    free(pairs);
+    free(latencies);
+}
+
+/**
+ * `bench suite`: generate the requested graphs and run every engine on them
+ */
+static int runSuite(int argc, char* argv[]) {
+    SuiteOptions options = {"all", 10000, 1000, METRIC_DISTANCE, false, false, 12345u};
+
+    for (int i = 2; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--graph") == 0 && hasValue) {
+            options.graphKind = argv[++i];
+        } else if (strcmp(argv[i], "--nodes") == 0 && hasValue) {
+            options.nodes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--queries") == 0 && hasValue) {
+            options.queries = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--metric") == 0 && hasValue) {
+            options.metric = parseWeightType(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--format") == 0 && hasValue) {
+            options.json = strcmp(argv[++i], "jsonl") == 0 || strcmp(argv[i], "json") == 0;
+        } else if (strcmp(argv[i], "--no-ch") == 0) {
+            options.skipCH = true;
+        } else {
+            fprintf(stderr, "Usage: %s suite [--graph grid|geometric|scalefree|all] [--nodes N]\n"
+                            "       [--queries Q] [--metric distance|time|cost] [--seed S]\n"
+                            "       [--format csv|jsonl] [--no-ch]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.nodes < 1 || options.queries < 1 || options.seed == 0) {
+        fprintf(stderr, "Error: --nodes, --queries and --seed must be positive\n");
+        return 2;
+    }
+
+    if (!options.json) {
+        printf("graph,nodes,edges,engine,metric,queries,found,p50_us,p90_us,p99_us,"
+               "mean_us,mean_settled,qps,preprocess_ms\n");
+    }
+
+    const char* kinds[] = {"grid", "geometric", "scalefree"};
+    for (int k = 0; k < 3; k++) {
+        if (strcmp(options.graphKind, "all") != 0 && strcmp(options.graphKind, kinds[k]) != 0) {
+            continue;
+        }
+        // Same graph for the same seed, independent of the query set
+        benchSeed = options.seed * 2654435761u + k + 1;
+        if (benchSeed == 0) benchSeed = 1;
+        Graph* graph = k == 0 ? buildGridGraph((int)ceil(sqrt((double)options.nodes))) :
+                       k == 1 ? buildGeometricGraph(options.nodes, 6.0) :
+                                buildScaleFreeGraph(options.nodes, 3);
+        if (!graph) {
+            fprintf(stderr, "Error: Failed to generate %s graph\n", kinds[k]);
+            return 1;
+        }
+        runSuiteOnGraph(&options, kinds[k], graph);
+        fflush(stdout);
+        destroyGraph(graph);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "suite") == 0) return runSuite(argc, argv);
+        fprintf(stderr, "Usage: %s [suite [options]]\n", argv[0]);
+        return 2;
+    }
+
+    printf("========================================\n");
+    printf("  Travel Route Planner - Benchmarks     \n");
+    printf("========================================\n");
+
+    benchSampleGraph();
+    benchGridScaling();
+    benchGraphLoad();
+    benchGraphFile();
+    benchCSVLoad();
+    benchAllocations();
+    benchHeuristic();
+    benchLandmarks();
+    benchModeFilter();
+    benchKShortestPaths();
+    benchTreeCache();
+    benchRouteUpdates();
+    benchDeltaStepping();
+    benchDistanceMatrix();
+    benchPareto();
+    benchTimetable();
+    benchQueryPool();
+    benchContractionHierarchies();
+    benchHeapScaling();
+
+    return 0;
+}
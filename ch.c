@@ -0,0 +1,540 @@
+/**
+ * Contraction Hierarchies Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Preprocessing contracts cities one at a time (cheapest first by edge
+ * difference), adding a shortcut u -> x through v only when no witness
+ * path u -> x avoiding v is as short. Queries then run a bidirectional
+ * Dijkstra that only ever climbs in rank, which settles a tiny fraction
+ * of the graph.
+ */
+
+#include "ch.h"
+
+// Edge of the graph being contracted
+typedef struct {
+    int neighbor;
+    int weight;
+    int edge;
+} CHArc;
+
+typedef struct {
+    CHArc* arcs;
+    int count;
+    int capacity;
+} CHArcList;
+
+// Growable int array used while building and unpacking
+typedef struct {
+    int* items;
+    int count;
+    int capacity;
+} IntBuffer;
+
+// Preprocessing state
+typedef struct {
+    int n;
+    CHArcList* out;
+    CHArcList* in;
+    bool* contracted;
+    int* deletedNeighbors;
+    int* level;               // 1 + highest level of any contracted neighbour
+    int* targetMark;          // == markRound for the current witness targets
+    int markRound;
+    IntBuffer from, to, weight, originalEdge, firstHalf, secondHalf;
+    QueryContext* witness;
+} CHBuilder;
+
+static bool pushInt(IntBuffer* buffer, int value) {
+    if (buffer->count == buffer->capacity) {
+        int capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 64;
+        int* items = (int*)realloc(buffer->items, capacity * sizeof(int));
+        if (!items) return false;
+        buffer->items = items;
+        buffer->capacity = capacity;
+    }
+    buffer->items[buffer->count++] = value;
+    return true;
+}
+
+static int findArc(const CHArcList* list, int neighbor) {
+    for (int i = 0; i < list->count; i++) {
+        if (list->arcs[i].neighbor == neighbor) return i;
+    }
+    return -1;
+}
+
+static bool appendArc(CHArcList* list, int neighbor, int weight, int edge) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+        CHArc* arcs = (CHArc*)realloc(list->arcs, capacity * sizeof(CHArc));
+        if (!arcs) return false;
+        list->arcs = arcs;
+        list->capacity = capacity;
+    }
+    list->arcs[list->count].neighbor = neighbor;
+    list->arcs[list->count].weight = weight;
+    list->arcs[list->count].edge = edge;
+    list->count++;
+    return true;
+}
+
+/**
+ * Add edge u -> x unless an equal or shorter one already exists;
+ * a longer existing arc is replaced in both directions
+ */
+static bool connect(CHBuilder* b, int u, int x, int weight, int original, int first, int second) {
+    int existing = findArc(&b->out[u], x);
+    if (existing != -1 && b->out[u].arcs[existing].weight <= weight) {
+        return true;
+    }
+    
+    int edge = b->from.count;
+    if (!pushInt(&b->from, u) || !pushInt(&b->to, x) || !pushInt(&b->weight, weight) ||
+        !pushInt(&b->originalEdge, original) || !pushInt(&b->firstHalf, first) ||
+        !pushInt(&b->secondHalf, second)) {
+        return false;
+    }
+    
+    if (existing != -1) {
+        CHArc* forwardArc = &b->out[u].arcs[existing];
+        CHArc* backwardArc = &b->in[x].arcs[findArc(&b->in[x], u)];
+        forwardArc->weight = backwardArc->weight = weight;
+        forwardArc->edge = backwardArc->edge = edge;
+        return true;
+    }
+    return appendArc(&b->out[u], x, weight, edge) && appendArc(&b->in[x], u, weight, edge);
+}
+
+/**
+ * Bounded Dijkstra from source over uncontracted cities, skipping `avoid`;
+ * stops early once all `targets` marked cities are settled
+ */
+static void witnessSearch(CHBuilder* b, int source, int avoid, int limit, int settleLimit,
+                          int targets) {
+    QueryContext* ctx = b->witness;
+    beginQuery(ctx, b->n);
+    
+    touchCity(ctx, source);
+    ctx->dist[source] = 0;
+    heapPushOrDecrease(&ctx->heap, source, 0);
+    
+    int settled = 0;
+    while (!heapIsEmpty(&ctx->heap) && heapMinPriority(&ctx->heap) <= limit &&
+           settled < settleLimit) {
+        int current = heapPopMin(&ctx->heap);
+        settled++;
+        if (b->targetMark[current] == b->markRound && --targets == 0) break;
+        
+        const CHArcList* list = &b->out[current];
+        for (int i = 0; i < list->count; i++) {
+            int next = list->arcs[i].neighbor;
+            if (next == avoid || b->contracted[next]) continue;
+            
+            int newDist = ctx->dist[current] + list->arcs[i].weight;
+            touchCity(ctx, next);
+            if (newDist < ctx->dist[next]) {
+                ctx->dist[next] = newDist;
+                heapPushOrDecrease(&ctx->heap, next, newDist);
+            }
+        }
+    }
+}
+
+/**
+ * Contract v (or only count the shortcuts it would need when simulating).
+ * Returns the shortcut count, or -1 on allocation failure.
+ */
+static int contractNode(CHBuilder* b, int v, bool simulate) {
+    int shortcuts = 0;
+    
+    for (int i = 0; i < b->in[v].count; i++) {
+        CHArc incoming = b->in[v].arcs[i];
+        int u = incoming.neighbor;
+        if (b->contracted[u]) continue;
+        
+        int maxOut = -1, targets = 0;
+        b->markRound++;
+        for (int j = 0; j < b->out[v].count; j++) {
+            const CHArc* outgoing = &b->out[v].arcs[j];
+            if (outgoing->neighbor == u || b->contracted[outgoing->neighbor]) continue;
+            if (outgoing->weight > maxOut) maxOut = outgoing->weight;
+            if (b->targetMark[outgoing->neighbor] != b->markRound) {
+                b->targetMark[outgoing->neighbor] = b->markRound;
+                targets++;
+            }
+        }
+        if (maxOut < 0) continue;
+        
+        witnessSearch(b, u, v, incoming.weight + maxOut,
+                      simulate ? CH_SIMULATE_SETTLE_LIMIT : CH_WITNESS_SETTLE_LIMIT, targets);
+        
+        for (int j = 0; j < b->out[v].count; j++) {
+            CHArc outgoing = b->out[v].arcs[j];
+            int x = outgoing.neighbor;
+            if (x == u || b->contracted[x]) continue;
+            
+            int via = incoming.weight + outgoing.weight;
+            touchCity(b->witness, x);
+            if (b->witness->dist[x] <= via) continue;
+            
+            shortcuts++;
+            if (!simulate && !connect(b, u, x, via, -1, incoming.edge, outgoing.edge)) {
+                return -1;
+            }
+        }
+    }
+    return shortcuts;
+}
+
+/**
+ * Contraction priority: edge difference plus already-contracted neighbours
+ * and level (the latter two spread contraction evenly over the graph)
+ */
+static int nodePriority(CHBuilder* b, int v) {
+    int degree = 0;
+    for (int i = 0; i < b->in[v].count; i++) {
+        degree += !b->contracted[b->in[v].arcs[i].neighbor];
+    }
+    for (int i = 0; i < b->out[v].count; i++) {
+        degree += !b->contracted[b->out[v].arcs[i].neighbor];
+    }
+    return 4 * (contractNode(b, v, true) - degree) + 2 * b->deletedNeighbors[v] + b->level[v];
+}
+
+static void freeBuilder(CHBuilder* b) {
+    if (b->out) {
+        for (int i = 0; i < b->n; i++) free(b->out[i].arcs);
+    }
+    if (b->in) {
+        for (int i = 0; i < b->n; i++) free(b->in[i].arcs);
+    }
+    free(b->out);
+    free(b->in);
+    free(b->contracted);
+    free(b->deletedNeighbors);
+    free(b->level);
+    free(b->targetMark);
+    free(b->from.items);
+    free(b->to.items);
+    free(b->weight.items);
+    destroyQueryContext(b->witness);
+    // originalEdge/firstHalf/secondHalf are handed over to the hierarchy
+}
+
+/**
+ * Split the final edge set into upward (forward search) and
+ * from-higher-rank (backward search) adjacency arrays
+ */
+static bool assembleHierarchy(ContractionHierarchy* ch, const CHBuilder* b) {
+    int n = ch->numCities;
+    int m = b->from.count > 0 ? b->from.count : 1;
+    
+    ch->upOffsets = (int*)calloc(n + 1, sizeof(int));
+    ch->downOffsets = (int*)calloc(n + 1, sizeof(int));
+    ch->upTarget = (int*)malloc(m * sizeof(int));
+    ch->upWeight = (int*)malloc(m * sizeof(int));
+    ch->upEdge = (int*)malloc(m * sizeof(int));
+    ch->downSource = (int*)malloc(m * sizeof(int));
+    ch->downWeight = (int*)malloc(m * sizeof(int));
+    ch->downEdge = (int*)malloc(m * sizeof(int));
+    if (!ch->upOffsets || !ch->downOffsets || !ch->upTarget || !ch->upWeight ||
+        !ch->upEdge || !ch->downSource || !ch->downWeight || !ch->downEdge) {
+        return false;
+    }
+    
+    for (int g = 0; g < b->from.count; g++) {
+        int u = b->from.items[g], x = b->to.items[g];
+        if (ch->rank[u] < ch->rank[x]) {
+            ch->upOffsets[u + 1]++;
+        } else {
+            ch->downOffsets[x + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        ch->upOffsets[i + 1] += ch->upOffsets[i];
+        ch->downOffsets[i + 1] += ch->downOffsets[i];
+    }
+    
+    // Fill using the offsets as cursors, then shift them back
+    for (int g = 0; g < b->from.count; g++) {
+        int u = b->from.items[g], x = b->to.items[g];
+        if (ch->rank[u] < ch->rank[x]) {
+            int slot = ch->upOffsets[u]++;
+            ch->upTarget[slot] = x;
+            ch->upWeight[slot] = b->weight.items[g];
+            ch->upEdge[slot] = g;
+        } else {
+            int slot = ch->downOffsets[x]++;
+            ch->downSource[slot] = u;
+            ch->downWeight[slot] = b->weight.items[g];
+            ch->downEdge[slot] = g;
+        }
+    }
+    for (int i = n; i > 0; i--) {
+        ch->upOffsets[i] = ch->upOffsets[i - 1];
+        ch->downOffsets[i] = ch->downOffsets[i - 1];
+    }
+    ch->upOffsets[0] = 0;
+    ch->downOffsets[0] = 0;
+    return true;
+}
+
+/**
+ * Preprocess the graph for one metric
+ */
+ContractionHierarchy* buildContractionHierarchy(Graph* graph, WeightMetric metric) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr) return NULL;
+    
+    int n = csr->numCities;
+    const int* weights = csrWeights(csr, metric);
+    
+    ContractionHierarchy* ch = (ContractionHierarchy*)calloc(1, sizeof(ContractionHierarchy));
+    CHBuilder b;
+    memset(&b, 0, sizeof(b));
+    b.n = n;
+    b.out = (CHArcList*)calloc(n > 0 ? n : 1, sizeof(CHArcList));
+    b.in = (CHArcList*)calloc(n > 0 ? n : 1, sizeof(CHArcList));
+    b.contracted = (bool*)calloc(n > 0 ? n : 1, sizeof(bool));
+    b.deletedNeighbors = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    b.level = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    b.targetMark = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    b.witness = createQueryContext(n);
+    MinHeap* order = createMinHeap(n);
+    
+    bool ok = ch && b.out && b.in && b.contracted && b.deletedNeighbors && b.level && b.targetMark && b.witness && order;
+    if (ok) {
+        ch->metric = metric;
+        ch->graphVersion = graph->version;
+        ch->numCities = n;
+        ch->rank = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        ok = ch->rank != NULL;
+    }
+    
+    // Original edges (self-loops never lie on a shortest path)
+    for (int u = 0; ok && u < n; u++) {
+        for (int e = csr->offsets[u]; ok && e < csr->offsets[u + 1]; e++) {
+            if (csr->target[e] != u) {
+                ok = connect(&b, u, csr->target[e], weights[e], e, -1, -1);
+            }
+        }
+    }
+    
+    for (int v = 0; ok && v < n; v++) {
+        heapPushOrDecrease(order, v, nodePriority(&b, v));
+    }
+    
+    // Contract cheapest first. Neighbours only get the cheap deleted/level
+    // terms bumped; the full (witness-search) priority is recomputed lazily
+    // when a city reaches the top of the queue
+    int nextRank = 0;
+    while (ok && !heapIsEmpty(order)) {
+        int v = heapPopMin(order);
+        int priority = nodePriority(&b, v);
+        if (!heapIsEmpty(order) && priority > heapMinPriority(order)) {
+            heapPushOrDecrease(order, v, priority);
+            continue;
+        }
+        
+        int added = contractNode(&b, v, false);
+        if (added < 0) {
+            ok = false;
+            break;
+        }
+        ch->numShortcuts += added;
+        b.contracted[v] = true;
+        ch->rank[v] = nextRank++;
+        
+        for (int pass = 0; pass < 2; pass++) {
+            const CHArcList* list = pass == 0 ? &b.in[v] : &b.out[v];
+            for (int i = 0; i < list->count; i++) {
+                int x = list->arcs[i].neighbor;
+                if (b.contracted[x]) continue;
+                int bump = 2;
+                b.deletedNeighbors[x]++;
+                if (b.level[x] < b.level[v] + 1) {
+                    bump += b.level[v] + 1 - b.level[x];
+                    b.level[x] = b.level[v] + 1;
+                }
+                heapUpdatePriority(order, x, order->entries[order->position[x]].priority + bump);
+            }
+        }
+    }
+    
+    if (ok) {
+        ch->numEdges = b.from.count;
+        ch->originalEdge = b.originalEdge.items;
+        ch->firstHalf = b.firstHalf.items;
+        ch->secondHalf = b.secondHalf.items;
+        b.originalEdge.items = b.firstHalf.items = b.secondHalf.items = NULL;
+        ok = assembleHierarchy(ch, &b);
+    }
+    
+    free(b.originalEdge.items);
+    free(b.firstHalf.items);
+    free(b.secondHalf.items);
+    freeBuilder(&b);
+    destroyMinHeap(order);
+    
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for contraction hierarchy\n");
+        destroyContractionHierarchy(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+/**
+ * Destroy hierarchy and free memory
+ */
+void destroyContractionHierarchy(ContractionHierarchy* ch) {
+    if (!ch) return;
+    
+    free(ch->rank);
+    free(ch->originalEdge);
+    free(ch->firstHalf);
+    free(ch->secondHalf);
+    free(ch->upOffsets);
+    free(ch->upTarget);
+    free(ch->upWeight);
+    free(ch->upEdge);
+    free(ch->downOffsets);
+    free(ch->downSource);
+    free(ch->downWeight);
+    free(ch->downEdge);
+    free(ch);
+}
+
+/**
+ * Bytes held by the hierarchy
+ */
+size_t getHierarchyMemoryBytes(const ContractionHierarchy* ch) {
+    if (!ch) return 0;
+    return sizeof(ContractionHierarchy) +
+           (size_t)ch->numCities * sizeof(int) +              // rank
+           2 * (size_t)(ch->numCities + 1) * sizeof(int) +    // up/down offsets
+           (size_t)ch->numEdges * 6 * sizeof(int);            // unpack info + adjacency
+}
+
+/**
+ * Expand one hierarchy edge into the CSR edges it stands for
+ */
+static bool unpackEdge(const ContractionHierarchy* ch, int edge, IntBuffer* path, IntBuffer* stack) {
+    stack->count = 0;
+    if (!pushInt(stack, edge)) return false;
+    
+    while (stack->count > 0) {
+        int current = stack->items[--stack->count];
+        if (ch->originalEdge[current] != -1) {
+            if (!pushInt(path, ch->originalEdge[current])) return false;
+        } else if (!pushInt(stack, ch->secondHalf[current]) ||
+                   !pushInt(stack, ch->firstHalf[current])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Shortest path query on a hierarchy built from this graph's current version
+ */
+PathResult* chQuery(Graph* graph, const ContractionHierarchy* ch, QueryContext* forward,
+                    QueryContext* backward, int start, int end) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || !ch || ch->graphVersion != graph->version) return NULL;
+    if (!beginQuery(forward, ch->numCities) || !beginQuery(backward, ch->numCities)) return NULL;
+    
+    touchCity(forward, start);
+    touchCity(backward, end);
+    forward->dist[start] = 0;
+    backward->dist[end] = 0;
+    heapPushOrDecrease(&forward->heap, start, 0);
+    heapPushOrDecrease(&backward->heap, end, 0);
+    
+    int best = INFINITY_DIST;
+    int meet = -1;
+    
+    // Each side only climbs in rank; a side stops once its minimum reaches best
+    while (true) {
+        bool forwardActive = !heapIsEmpty(&forward->heap) &&
+                             heapMinPriority(&forward->heap) < best;
+        bool backwardActive = !heapIsEmpty(&backward->heap) &&
+                              heapMinPriority(&backward->heap) < best;
+        if (!forwardActive && !backwardActive) break;
+        
+        bool stepForward = forwardActive &&
+            (!backwardActive || heapMinPriority(&forward->heap) <= heapMinPriority(&backward->heap));
+        QueryContext* self = stepForward ? forward : backward;
+        QueryContext* other = stepForward ? backward : forward;
+        
+        int current = heapPopMin(&self->heap);
+        markVisited(self, current);
+        
+        touchCity(other, current);
+        if (other->dist[current] != INFINITY_DIST &&
+            self->dist[current] + other->dist[current] < best) {
+            best = self->dist[current] + other->dist[current];
+            meet = current;
+        }
+        
+        const int* offsets = stepForward ? ch->upOffsets : ch->downOffsets;
+        const int* neighbors = stepForward ? ch->upTarget : ch->downSource;
+        const int* weights = stepForward ? ch->upWeight : ch->downWeight;
+        const int* edges = stepForward ? ch->upEdge : ch->downEdge;
+        
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int next = neighbors[i];
+            int newDist = self->dist[current] + weights[i];
+            
+            touchCity(self, next);
+            if (newDist < self->dist[next]) {
+                self->dist[next] = newDist;
+                self->parent[next] = current;
+                self->parentEdge[next] = edges[i];
+                heapPushOrDecrease(&self->heap, next, newDist);
+            }
+        }
+    }
+    
+    if (meet == -1) {
+        return NULL;
+    }
+    
+    // Hierarchy edges start -> meet, then meet -> end, each unpacked in order
+    IntBuffer upward = {NULL, 0, 0}, path = {NULL, 0, 0}, stack = {NULL, 0, 0};
+    bool ok = true;
+    for (int current = meet; ok && forward->parent[current] != -1; current = forward->parent[current]) {
+        ok = pushInt(&upward, forward->parentEdge[current]);
+    }
+    for (int i = upward.count - 1; ok && i >= 0; i--) {
+        ok = unpackEdge(ch, upward.items[i], &path, &stack);
+    }
+    for (int current = meet; ok && backward->parent[current] != -1; current = backward->parent[current]) {
+        ok = unpackEdge(ch, backward->parentEdge[current], &path, &stack);
+    }
+    
+    PathResult* result = NULL;
+    if (ok) {
+        result = buildPathFromEdges(csr, start, path.items, path.count, "Contraction Hierarchies");
+    }
+    free(upward.items);
+    free(path.items);
+    free(stack.items);
+    return result;
+}
+
+PathResult* chShortestPath(Graph* graph, const ContractionHierarchy* ch,
+                           const char* startId, const char* endId) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
+    
+    if (start == -1 || end == -1) {
+        return NULL;
+    }
+    
+    QueryContext* forward = getGraphQueryContext(graph, false);
+    QueryContext* backward = getGraphQueryContext(graph, true);
+    if (!forward || !backward) return NULL;
+    return chQuery(graph, ch, forward, backward, start, end);
+}
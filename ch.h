@@ -0,0 +1,57 @@
+/**
+ * Contraction Hierarchies Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef CH_H
+#define CH_H
+
+#include "graph.h"
+#include "query.h"
+
+// Witness searches give up after settling this many cities (fewer while
+// only estimating priorities); a missed witness only adds a redundant
+// shortcut, never a wrong answer
+#define CH_WITNESS_SETTLE_LIMIT 500
+#define CH_SIMULATE_SETTLE_LIMIT 50
+
+// Preprocessed hierarchy for one metric. Every edge (original or shortcut)
+// has an id; shortcuts remember the two edges they replace so query
+// results can be unpacked back into real routes.
+typedef struct {
+    WeightMetric metric;
+    unsigned long graphVersion;   // Graph.version the hierarchy was built from
+    int numCities;
+    int numEdges;                 // original + shortcut edges
+    int numShortcuts;
+    int* rank;                    // contraction order of each city
+    
+    // Per edge id: CSR edge for originals (-1 for shortcuts) and the
+    // two halves for shortcuts (-1 for originals)
+    int* originalEdge;
+    int* firstHalf;
+    int* secondHalf;
+    
+    // Upward edges (to higher rank) by source, for the forward search
+    int* upOffsets;
+    int* upTarget;
+    int* upWeight;
+    int* upEdge;
+    
+    // Edges arriving from higher rank, by target, for the backward search
+    int* downOffsets;
+    int* downSource;
+    int* downWeight;
+    int* downEdge;
+} ContractionHierarchy;
+
+ContractionHierarchy* buildContractionHierarchy(Graph* graph, WeightMetric metric);
+void destroyContractionHierarchy(ContractionHierarchy* ch);
+size_t getHierarchyMemoryBytes(const ContractionHierarchy* ch);
+
+PathResult* chQuery(Graph* graph, const ContractionHierarchy* ch, QueryContext* forward,
+                    QueryContext* backward, int start, int end);
+PathResult* chShortestPath(Graph* graph, const ContractionHierarchy* ch,
+                           const char* startId, const char* endId);
+
+#endif // CH_H
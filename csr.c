@@ -0,0 +1,160 @@
+/**
+ * CSR Graph Snapshot Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Flattens the adjacency lists into offset + struct-of-arrays form so the
+ * search kernels scan each city's edges sequentially.
+ */
+
+#include "graph.h"
+
+/**
+ * Group every edge by its target (counting sort) so backward searches can
+ * scan incoming edges of a city as sequentially as outgoing ones
+ */
+bool buildReverseIndex(CSRGraph* csr) {
+    int n = csr->numCities;
+    int edgeSlots = csr->numEdges > 0 ? csr->numEdges : 1;
+    
+    csr->revOffsets = (int*)calloc(n + 1, sizeof(int));
+    csr->revSource = (int*)malloc(edgeSlots * sizeof(int));
+    csr->revEdge = (int*)malloc(edgeSlots * sizeof(int));
+    if (!csr->revOffsets || !csr->revSource || !csr->revEdge) {
+        return false;
+    }
+    
+    for (int e = 0; e < csr->numEdges; e++) {
+        csr->revOffsets[csr->target[e] + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        csr->revOffsets[i + 1] += csr->revOffsets[i];
+    }
+    
+    // Fill using revOffsets[i] as a cursor, then shift back into place
+    for (int u = 0; u < n; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int slot = csr->revOffsets[csr->target[e]]++;
+            csr->revSource[slot] = u;
+            csr->revEdge[slot] = e;
+        }
+    }
+    for (int i = n; i > 0; i--) {
+        csr->revOffsets[i] = csr->revOffsets[i - 1];
+    }
+    csr->revOffsets[0] = 0;
+    return true;
+}
+
+/**
+ * Allocate a CSR snapshot with room for numEdges edges and fill in the
+ * city positions and the graph's mode names; offsets and edge arrays are
+ * left for the caller
+ */
+CSRGraph* createCSRGraph(Graph* graph, int numEdges) {
+    CSRGraph* csr = (CSRGraph*)calloc(1, sizeof(CSRGraph));
+    if (!csr) {
+        fprintf(stderr, "Error: Memory allocation failed for CSR graph\n");
+        return NULL;
+    }
+    
+    int n = graph->numCities;
+    int edgeSlots = numEdges > 0 ? numEdges : 1;
+    csr->numCities = n;
+    csr->numEdges = numEdges;
+    csr->offsets = (int*)malloc((n + 1) * sizeof(int));
+    csr->target = (int*)malloc(edgeSlots * sizeof(int));
+    csr->distance = (int*)malloc(edgeSlots * sizeof(int));
+    csr->time = (double*)malloc(edgeSlots * sizeof(double));
+    csr->timeWeight = (int*)malloc(edgeSlots * sizeof(int));
+    csr->cost = (int*)malloc(edgeSlots * sizeof(int));
+    csr->modeId = (unsigned char*)malloc(edgeSlots * sizeof(unsigned char));
+    csr->position = (double*)malloc((n > 0 ? 3 * (size_t)n : 1) * sizeof(double));
+    
+    if (!csr->offsets || !csr->target || !csr->distance || !csr->time ||
+        !csr->timeWeight || !csr->cost || !csr->modeId || !csr->position) {
+        fprintf(stderr, "Error: Memory allocation failed for CSR graph\n");
+        destroyCSRGraph(csr);
+        return NULL;
+    }
+    
+    csr->numModes = graph->numModes;
+    memcpy(csr->modeNames, graph->modeNames, sizeof(csr->modeNames));
+    
+    // Trig happens once per city here instead of once per A* relaxation
+    for (int i = 0; i < n; i++) {
+        double lat = graph->cities[i].latitude * M_PI / 180.0;
+        double lon = graph->cities[i].longitude * M_PI / 180.0;
+        csr->position[3 * i] = EARTH_RADIUS_KM * cos(lat) * cos(lon);
+        csr->position[3 * i + 1] = EARTH_RADIUS_KM * cos(lat) * sin(lon);
+        csr->position[3 * i + 2] = EARTH_RADIUS_KM * sin(lat);
+    }
+    return csr;
+}
+
+/**
+ * Build (or return the cached) CSR snapshot of the graph.
+ * The snapshot stays valid until the next addCity/addRoute.
+ */
+CSRGraph* freezeGraph(Graph* graph) {
+    if (!graph) return NULL;
+    if (graph->frozen) return graph->frozen;
+    
+    int n = graph->numCities;
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        for (AdjNode* node = graph->adjList[i]; node; node = node->next) {
+            m++;
+        }
+    }
+    
+    CSRGraph* csr = createCSRGraph(graph, m);
+    if (!csr) return NULL;
+    
+    int e = 0;
+    for (int i = 0; i < n; i++) {
+        csr->offsets[i] = e;
+        for (AdjNode* node = graph->adjList[i]; node; node = node->next) {
+            csr->target[e] = node->cityIndex;
+            csr->distance[e] = node->distance;
+            csr->time[e] = node->time;
+            csr->timeWeight[e] = (int)(node->time * 100); // Same scale as getWeight
+            csr->cost[e] = node->cost;
+            csr->modeId[e] = node->modeId;
+            e++;
+        }
+    }
+    csr->offsets[n] = e;
+    
+    if (!buildReverseIndex(csr)) {
+        fprintf(stderr, "Error: Memory allocation failed for CSR graph\n");
+        destroyCSRGraph(csr);
+        return NULL;
+    }
+    
+    graph->frozen = csr;
+    return csr;
+}
+
+/**
+ * Destroy CSR snapshot and free memory
+ */
+void destroyCSRGraph(CSRGraph* csr) {
+    if (!csr) return;
+    
+    if (csr->external) {
+        free(csr);
+        return;
+    }
+    free(csr->offsets);
+    free(csr->target);
+    free(csr->distance);
+    free(csr->time);
+    free(csr->timeWeight);
+    free(csr->cost);
+    free(csr->modeId);
+    free(csr->revOffsets);
+    free(csr->revSource);
+    free(csr->revEdge);
+    free(csr->position);
+    free(csr);
+}
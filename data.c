@@ -6,9 +6,9 @@
 #include "graph.h"
 
 /**
- * Initialize graph with sample Indian cities and routes
+ * Add the sample Indian cities and routes without printing anything
  */
-void initializeSampleData(Graph* graph) {
+void loadSampleData(Graph* graph) {
     if (!graph) return;
     
     // Add Indian cities with coordinates
@@ -99,7 +99,15 @@ void initializeSampleData(Graph* graph) {
     // Nagpur connections
     addRoute(graph, "nagpur", "indore", 390, 6.0, 700, "Train");
     addRoute(graph, "nagpur", "bhopal", 350, 5.5, 650, "Train");
+}
+
+/**
+ * Initialize graph with sample Indian cities and routes
+ */
+void initializeSampleData(Graph* graph) {
+    if (!graph) return;
     
+    loadSampleData(graph);
     printf("Initialized graph with %d Indian cities and %d routes\n", 
            graph->numCities, graph->numRoutes);
 }
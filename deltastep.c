@@ -0,0 +1,446 @@
+/**
+ * Delta-Stepping Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Cities wait in buckets of width delta by tentative distance. The lowest
+ * non-empty bucket is emptied in rounds: all threads share out its cities
+ * and relax their light edges (weight <= delta), which may refill it; once
+ * it stays empty the heavy edges of every city it held are relaxed once.
+ * Distances are lowered with compare-and-swap and each thread files the
+ * cities it improved in its own cyclic buckets, so the distances are the
+ * only shared writes.
+ *
+ * Parents are picked after the search from the final distances: the
+ * nearest predecessor, as in dijkstraOneToAll, with ties going to the lower
+ * city index rather than heap order, so the tree never depends on thread
+ * timing.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "deltastep.h"
+#include "matrix.h"
+
+#define DELTA_CHUNK 64        // cities a thread takes at a time in a light round
+#define PARENT_PENDING (-2)   // parentEdge of a city only reached over zero-weight edges, for now
+
+typedef struct {
+    int* items;
+    int size;
+    int capacity;
+} CityList;
+
+typedef struct DeltaJob DeltaJob;
+
+typedef struct {
+    DeltaJob* job;
+    int id;
+    CityList* buckets;        // numSlots cyclic buckets of the cities this thread improved
+    CityList frontier;        // cities this thread took from the current bucket this round
+    CityList settled;         // every city taken from the current bucket, for its heavy edges
+    int nextBucket;           // lowest bucket this thread holds cities for, INT_MAX if none
+    int numPending;
+} DeltaWorker;
+
+// Reusable barrier; the party count is fixed once every thread has started
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t released;
+    int parties;
+    int waiting;
+    unsigned int round;
+} PhaseBarrier;
+
+struct DeltaJob {
+    const CSRGraph* csr;
+    const int* weights;
+    int delta;
+    int numSlots;             // buckets in flight at once: maxWeight / delta + 2
+    atomic_int* dist;
+    atomic_int* expanded;     // distance a city's light edges were last relaxed from
+    DeltaWorker* workers;
+    int numWorkers;
+    atomic_int nextItem;      // shared work counter of the current light round
+    atomic_bool failed;
+    PhaseBarrier barrier;
+    ShortestPathTree* tree;
+};
+
+static void waitBarrier(PhaseBarrier* barrier) {
+    pthread_mutex_lock(&barrier->lock);
+    unsigned int round = barrier->round;
+    if (++barrier->waiting == barrier->parties) {
+        barrier->waiting = 0;
+        barrier->round++;
+        pthread_cond_broadcast(&barrier->released);
+    } else {
+        while (round == barrier->round) {
+            pthread_cond_wait(&barrier->released, &barrier->lock);
+        }
+    }
+    pthread_mutex_unlock(&barrier->lock);
+}
+
+static bool pushCity(CityList* list, int city) {
+    if (list->size == list->capacity) {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 16;
+        int* items = (int*)realloc(list->items, capacity * sizeof(int));
+        if (!items) return false;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->size++] = city;
+    return true;
+}
+
+/**
+ * Lower dist[city] to newDist unless another thread got it lower; the
+ * thread that lowers it files the city in its own bucket
+ */
+static void relaxCity(DeltaWorker* worker, int city, int newDist) {
+    DeltaJob* job = worker->job;
+    int old = atomic_load_explicit(&job->dist[city], memory_order_relaxed);
+    while (newDist < old) {
+        if (atomic_compare_exchange_weak_explicit(&job->dist[city], &old, newDist,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            CityList* slot = &worker->buckets[(newDist / job->delta) % job->numSlots];
+            if (!pushCity(slot, city)) atomic_store(&job->failed, true);
+            return;
+        }
+    }
+}
+
+static void relaxEdges(DeltaWorker* worker, int city, bool heavy) {
+    const DeltaJob* job = worker->job;
+    const CSRGraph* csr = job->csr;
+    int dist = atomic_load_explicit(&job->dist[city], memory_order_relaxed);
+    for (int e = csr->offsets[city]; e < csr->offsets[city + 1]; e++) {
+        if ((job->weights[e] > job->delta) == heavy) {
+            relaxCity(worker, csr->target[e], dist + job->weights[e]);
+        }
+    }
+}
+
+/**
+ * Lowest bucket from `from` on that this thread holds cities for. Every
+ * tentative distance is below from * delta + maxWeight, so one lap of the
+ * cyclic array covers them all.
+ */
+static int lowestBucket(const DeltaWorker* worker, int from) {
+    int numSlots = worker->job->numSlots;
+    for (int k = 0; k < numSlots; k++) {
+        if (worker->buckets[(from + k) % numSlots].size > 0) return from + k;
+    }
+    return INT_MAX;
+}
+
+/**
+ * Move the cities still due in `bucket` out of this thread's slot. A city
+ * filed twice, or already relaxed at its current distance, is taken once.
+ */
+static void takeBucket(DeltaWorker* worker, int bucket) {
+    DeltaJob* job = worker->job;
+    CityList* slot = &worker->buckets[bucket % job->numSlots];
+    
+    worker->frontier.size = 0;
+    for (int i = 0; i < slot->size; i++) {
+        int city = slot->items[i];
+        int dist = atomic_load_explicit(&job->dist[city], memory_order_relaxed);
+        if (dist / job->delta != bucket) continue;
+        if (atomic_exchange_explicit(&job->expanded[city], dist, memory_order_relaxed) == dist) continue;
+        if (!pushCity(&worker->frontier, city) || !pushCity(&worker->settled, city)) {
+            atomic_store(&job->failed, true);
+        }
+    }
+    slot->size = 0;
+}
+
+/**
+ * Relax the light edges of this round's cities, DELTA_CHUNK at a time
+ * from whichever thread took them
+ */
+static void relaxLightRound(DeltaWorker* worker, int total) {
+    DeltaJob* job = worker->job;
+    for (;;) {
+        int item = atomic_fetch_add(&job->nextItem, DELTA_CHUNK);
+        if (item >= total) break;
+        int end = item + DELTA_CHUNK < total ? item + DELTA_CHUNK : total;
+        
+        int owner = 0;
+        int offset = item;
+        while (offset >= job->workers[owner].frontier.size) {
+            offset -= job->workers[owner].frontier.size;
+            owner++;
+        }
+        for (int i = item; i < end; i++) {
+            while (offset == job->workers[owner].frontier.size) {
+                owner++;
+                offset = 0;
+            }
+            relaxEdges(worker, job->workers[owner].frontier.items[offset++], false);
+        }
+    }
+}
+
+/**
+ * Parents of cities [from, to): among incoming edges on a shortest path,
+ * the one from the nearest city, then the lowest city index, then the
+ * first edge (dijkstraOneToAll also takes the nearest city and its first
+ * edge, but breaks equal distances by heap order).
+ * A city whose only such edges weigh zero from an equally far city is left
+ * PARENT_PENDING for linkZeroWeightCities.
+ */
+static void pickParents(DeltaWorker* worker, int from, int to) {
+    const DeltaJob* job = worker->job;
+    const CSRGraph* csr = job->csr;
+    ShortestPathTree* tree = job->tree;
+    
+    for (int city = from; city < to; city++) {
+        int dist = atomic_load_explicit(&job->dist[city], memory_order_relaxed);
+        tree->dist[city] = dist;
+        tree->parent[city] = -1;
+        tree->parentEdge[city] = -1;
+        if (city == tree->source || dist == INFINITY_DIST) continue;
+        
+        int bestDist = INFINITY_DIST;
+        for (int r = csr->revOffsets[city]; r < csr->revOffsets[city + 1]; r++) {
+            int prev = csr->revSource[r];
+            int e = csr->revEdge[r];
+            int prevDist = atomic_load_explicit(&job->dist[prev], memory_order_relaxed);
+            if (prevDist == INFINITY_DIST || prevDist + job->weights[e] != dist) continue;
+            if (prevDist < bestDist ||
+                (prevDist == bestDist && (prev < tree->parent[city] ||
+                                          (prev == tree->parent[city] && e < tree->parentEdge[city])))) {
+                bestDist = prevDist;
+                tree->parent[city] = prev;
+                tree->parentEdge[city] = e;
+            }
+        }
+        if (bestDist == dist) {
+            tree->parent[city] = -1;
+            tree->parentEdge[city] = PARENT_PENDING;
+            worker->numPending++;
+        }
+    }
+}
+
+static void* deltaWorker(void* arg) {
+    DeltaWorker* worker = (DeltaWorker*)arg;
+    DeltaJob* job = worker->job;
+    
+    waitBarrier(&job->barrier);   // numWorkers is final from here on
+    int current = 0;
+    for (;;) {
+        // Everyone agrees on the lowest bucket any thread still holds
+        worker->nextBucket = lowestBucket(worker, current);
+        waitBarrier(&job->barrier);
+        int bucket = INT_MAX;
+        for (int w = 0; w < job->numWorkers; w++) {
+            if (job->workers[w].nextBucket < bucket) bucket = job->workers[w].nextBucket;
+        }
+        if (bucket == INT_MAX) break;   // a failed push only drops work, the result is discarded
+        current = bucket;
+        if (worker->id == 0) job->tree->numBuckets++;
+        
+        for (;;) {
+            takeBucket(worker, bucket);
+            waitBarrier(&job->barrier);
+            int total = 0;
+            for (int w = 0; w < job->numWorkers; w++) {
+                total += job->workers[w].frontier.size;
+            }
+            if (total == 0) break;
+            if (worker->id == 0) job->tree->numPhases++;
+            
+            relaxLightRound(worker, total);
+            waitBarrier(&job->barrier);
+            if (worker->id == 0) atomic_store(&job->nextItem, 0);
+        }
+        
+        // The bucket is final; heavy edges land in later buckets
+        for (int i = 0; i < worker->settled.size; i++) {
+            relaxEdges(worker, worker->settled.items[i], true);
+        }
+        worker->settled.size = 0;
+    }
+    
+    int n = job->csr->numCities;
+    pickParents(worker, (int)((long long)n * worker->id / job->numWorkers),
+                (int)((long long)n * (worker->id + 1) / job->numWorkers));
+    return NULL;
+}
+
+/**
+ * Give every PARENT_PENDING city the lowest-index equally far city that
+ * reaches it over a zero-weight edge and already has a parent, until none
+ * is left
+ */
+static void linkZeroWeightCities(ShortestPathTree* tree, const CSRGraph* csr, const int* weights) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int city = 0; city < tree->numCities; city++) {
+            if (tree->parentEdge[city] != PARENT_PENDING) continue;
+            int best = -1;
+            int bestEdge = -1;
+            for (int r = csr->revOffsets[city]; r < csr->revOffsets[city + 1]; r++) {
+                int prev = csr->revSource[r];
+                int e = csr->revEdge[r];
+                if (weights[e] != 0 || tree->dist[prev] != tree->dist[city] ||
+                    tree->parentEdge[prev] == PARENT_PENDING) {
+                    continue;
+                }
+                if (best == -1 || prev < best || (prev == best && e < bestEdge)) {
+                    best = prev;
+                    bestEdge = e;
+                }
+            }
+            if (best != -1) {
+                tree->parent[city] = best;
+                tree->parentEdge[city] = bestEdge;
+                progress = true;
+            }
+        }
+    }
+}
+
+/**
+ * Mean edge weight of the metric, at least 1
+ */
+int defaultDeltaWidth(const CSRGraph* csr, WeightMetric metric) {
+    const int* weights = csrWeights(csr, metric);
+    long long total = 0;
+    for (int e = 0; e < csr->numEdges; e++) {
+        total += weights[e];
+    }
+    long long mean = csr->numEdges > 0 ? total / csr->numEdges : 1;
+    return mean > 0 ? (int)mean : 1;
+}
+
+/**
+ * One-to-all shortest paths from source with delta-stepping on numThreads
+ * threads (<= 0: one per processor). delta <= 0 uses defaultDeltaWidth.
+ * dist equals dijkstraOneToAll's; parents can differ only where the
+ * ShortestPathTree comment says. NULL on invalid input or allocation failure.
+ */
+ShortestPathTree* deltaSteppingQuery(Graph* graph, int source, WeightMetric metric, int delta,
+                                     int numThreads) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || source < 0 || source >= csr->numCities) return NULL;
+    
+    const int* weights = csrWeights(csr, metric);
+    int maxWeight = 0;
+    for (int e = 0; e < csr->numEdges; e++) {
+        if (weights[e] > maxWeight) maxWeight = weights[e];
+    }
+    if (delta <= 0) delta = defaultDeltaWidth(csr, metric);
+    if (maxWeight / delta + 2 > DELTA_MAX_BUCKETS) delta = maxWeight / (DELTA_MAX_BUCKETS - 2) + 1;
+    if (numThreads <= 0) numThreads = getDefaultThreadCount();
+    int n = csr->numCities;
+    
+    DeltaJob job;
+    job.csr = csr;
+    job.weights = weights;
+    job.delta = delta;
+    job.numSlots = maxWeight / delta + 2;
+    job.dist = (atomic_int*)malloc(n * sizeof(atomic_int));
+    job.expanded = (atomic_int*)malloc(n * sizeof(atomic_int));
+    job.workers = (DeltaWorker*)calloc(numThreads, sizeof(DeltaWorker));
+    job.numWorkers = numThreads;
+    atomic_init(&job.nextItem, 0);
+    atomic_init(&job.failed, false);
+    
+    ShortestPathTree* tree = (ShortestPathTree*)calloc(1, sizeof(ShortestPathTree));
+    int* block = (int*)malloc(3 * (size_t)n * sizeof(int));
+    bool ok = job.dist && job.expanded && job.workers && tree && block;
+    for (int w = 0; ok && w < numThreads; w++) {
+        job.workers[w].job = &job;
+        job.workers[w].id = w;
+        job.workers[w].buckets = (CityList*)calloc(job.numSlots, sizeof(CityList));
+        ok = job.workers[w].buckets != NULL;
+    }
+    
+    pthread_t* threads = NULL;
+    if (ok) {
+        tree->source = source;
+        tree->metric = metric;
+        tree->numCities = n;
+        tree->dist = block;
+        tree->parent = block + n;
+        tree->parentEdge = block + 2 * (size_t)n;
+        tree->delta = delta;
+        job.tree = tree;
+        for (int city = 0; city < n; city++) {
+            atomic_init(&job.dist[city], INFINITY_DIST);
+            atomic_init(&job.expanded[city], INFINITY_DIST);
+        }
+        atomic_store(&job.dist[source], 0);
+        ok = pushCity(&job.workers[0].buckets[0], source);
+        threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    }
+    
+    if (ok) {
+        pthread_mutex_init(&job.barrier.lock, NULL);
+        pthread_cond_init(&job.barrier.released, NULL);
+        job.barrier.parties = numThreads;
+        job.barrier.waiting = 0;
+        job.barrier.round = 0;
+        
+        // The calling thread is worker 0; the barrier counts the threads that started
+        int started = 0;
+        for (int t = 1; threads && t < numThreads; t++) {
+            if (pthread_create(&threads[started], NULL, deltaWorker, &job.workers[t]) != 0) break;
+            started++;
+        }
+        pthread_mutex_lock(&job.barrier.lock);
+        job.numWorkers = started + 1;
+        job.barrier.parties = started + 1;
+        pthread_mutex_unlock(&job.barrier.lock);
+        
+        deltaWorker(&job.workers[0]);
+        for (int t = 0; t < started; t++) {
+            pthread_join(threads[t], NULL);
+        }
+        pthread_mutex_destroy(&job.barrier.lock);
+        pthread_cond_destroy(&job.barrier.released);
+        
+        int numPending = 0;
+        for (int w = 0; w < job.numWorkers; w++) {
+            numPending += job.workers[w].numPending;
+        }
+        if (numPending > 0) linkZeroWeightCities(tree, csr, weights);
+        ok = !atomic_load(&job.failed);
+    }
+    
+    for (int w = 0; job.workers && w < numThreads; w++) {
+        for (int slot = 0; job.workers[w].buckets && slot < job.numSlots; slot++) {
+            free(job.workers[w].buckets[slot].items);
+        }
+        free(job.workers[w].buckets);
+        free(job.workers[w].frontier.items);
+        free(job.workers[w].settled.items);
+    }
+    free(job.workers);
+    free(job.dist);
+    free(job.expanded);
+    free(threads);
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for delta-stepping\n");
+        free(block);
+        free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+ShortestPathTree* deltaStepping(Graph* graph, const char* sourceId, const char* weightType) {
+    int source = findCityIndex(graph, sourceId);
+    if (source == -1) return NULL;
+    return deltaSteppingQuery(graph, source, parseWeightType(weightType), 0, 0);
+}
+
+void destroyShortestPathTree(ShortestPathTree* tree) {
+    if (!tree) return;
+    free(tree->dist);
+    free(tree);
+}
@@ -0,0 +1,38 @@
+/**
+ * Delta-Stepping Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef DELTASTEP_H
+#define DELTASTEP_H
+
+#include "graph.h"
+
+// Cap on the cyclic bucket array per thread; delta is raised to stay under it
+#define DELTA_MAX_BUCKETS 65536
+
+// One-to-all shortest-path tree, numCities entries per array. dist always
+// matches dijkstraOneToAll. parent/parentEdge match it too, except at a city
+// whose nearest predecessors on a shortest path are two or more different,
+// equally far cities (including only zero-weight edges from cities as far as
+// itself): dijkstraOneToAll keeps the one its heap settled first, this tree
+// the lowest city index. Either way every parent chain is a shortest path.
+typedef struct {
+    int source;
+    WeightMetric metric;
+    int numCities;
+    int* dist;                // INFINITY_DIST when unreachable; one block with the two below
+    int* parent;              // previous city on the shortest path, -1 at source / unreached
+    int* parentEdge;          // CSR edge from parent
+    int delta;                // bucket width used, in search units
+    int numBuckets;           // non-empty buckets processed
+    int numPhases;            // light-edge rounds, each one synchronization of all threads
+} ShortestPathTree;
+
+ShortestPathTree* deltaStepping(Graph* graph, const char* sourceId, const char* weightType);
+ShortestPathTree* deltaSteppingQuery(Graph* graph, int source, WeightMetric metric, int delta,
+                                     int numThreads);
+int defaultDeltaWidth(const CSRGraph* csr, WeightMetric metric);
+void destroyShortestPathTree(ShortestPathTree* tree);
+
+#endif // DELTASTEP_H
@@ -3,7 +3,56 @@
  * Travel Route Planner - C Implementation
  */
 
+#include <strings.h>
+#include <sys/mman.h>
 #include "graph.h"
+#include "query.h"
+#include "alt.h"
+
+/**
+ * FNV-1a hash of a city ID
+ */
+static unsigned int hashCityId(const char* id) {
+    unsigned int hash = 2166136261u;
+    while (*id) {
+        hash ^= (unsigned char)*id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Insert an existing city index into the id hash table (linear probing)
+ */
+static void indexCity(Graph* graph, int cityIndex) {
+    unsigned int mask = (unsigned int)graph->indexTableSize - 1;
+    unsigned int slot = hashCityId(graph->cities[cityIndex].id) & mask;
+    
+    while (graph->cityIndexTable[slot] != -1) {
+        slot = (slot + 1) & mask;
+    }
+    graph->cityIndexTable[slot] = cityIndex;
+}
+
+/**
+ * Allocate an empty id hash table and re-insert every city
+ */
+static bool rebuildCityIndex(Graph* graph, int tableSize) {
+    int* table = (int*)malloc(tableSize * sizeof(int));
+    if (!table) return false;
+    
+    for (int i = 0; i < tableSize; i++) {
+        table[i] = -1;
+    }
+    free(graph->cityIndexTable);
+    graph->cityIndexTable = table;
+    graph->indexTableSize = tableSize;
+    
+    for (int i = 0; i < graph->numCities; i++) {
+        indexCity(graph, i);
+    }
+    return true;
+}
 
 /**
  * Create a new graph
@@ -15,12 +64,44 @@ Graph* createGraph(bool isDirected) {
         return NULL;
     }
     
+    graph->cities = (City*)malloc(INITIAL_CITY_CAPACITY * sizeof(City));
+    graph->adjList = (AdjNode**)malloc(INITIAL_CITY_CAPACITY * sizeof(AdjNode*));
+    if (!graph->cities || !graph->adjList) {
+        fprintf(stderr, "Error: Memory allocation failed for graph\n");
+        free(graph->cities);
+        free(graph->adjList);
+        free(graph);
+        return NULL;
+    }
+    
+    graph->cityCapacity = INITIAL_CITY_CAPACITY;
+    graph->cityIndexTable = NULL;
     graph->numCities = 0;
     graph->numRoutes = 0;
     graph->isDirected = isDirected;
+    graph->version = 0;
+    graph->frozen = NULL;
+    graph->edgesOnlyInCSR = false;
+    graph->mapping = NULL;
+    graph->mappingSize = 0;
+    graph->numModes = 0;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        graph->landmarks[m] = NULL;
+    }
+    arenaInit(&graph->edgeArena);
+    graph->queryContext = NULL;
+    graph->reverseQueryContext = NULL;
+    
+    if (!rebuildCityIndex(graph, 2 * INITIAL_CITY_CAPACITY)) {
+        fprintf(stderr, "Error: Memory allocation failed for graph\n");
+        free(graph->cities);
+        free(graph->adjList);
+        free(graph);
+        return NULL;
+    }
     
     // Initialize adjacency list
-    for (int i = 0; i < MAX_CITIES; i++) {
+    for (int i = 0; i < graph->cityCapacity; i++) {
         graph->adjList[i] = NULL;
     }
     
@@ -33,24 +114,90 @@ Graph* createGraph(bool isDirected) {
 void destroyGraph(Graph* graph) {
     if (!graph) return;
     
-    // Free adjacency lists
-    for (int i = 0; i < graph->numCities; i++) {
-        AdjNode* current = graph->adjList[i];
-        while (current) {
-            AdjNode* temp = current;
-            current = current->next;
-            free(temp);
+    // Adjacency nodes live in the arena and are released block by block
+    arenaFree(&graph->edgeArena);
+    
+    destroyCSRGraph(graph->frozen);
+    destroyQueryContext(graph->queryContext);
+    destroyQueryContext(graph->reverseQueryContext);
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        destroyLandmarks(graph->landmarks[m]);
+    }
+    free(graph->adjList);
+    if (graph->mapping) {
+        // Cities and the id index point into the mapped file
+        munmap(graph->mapping, graph->mappingSize);
+    } else {
+        free(graph->cities);
+        free(graph->cityIndexTable);
+    }
+    free(graph);
+}
+
+/**
+ * Double city and adjacency storage (amortized O(1) per addCity)
+ */
+static bool growCities(Graph* graph) {
+    int newCapacity = graph->cityCapacity * 2;
+    
+    City* cities = (City*)realloc(graph->cities, newCapacity * sizeof(City));
+    if (!cities) return false;
+    graph->cities = cities;
+    
+    AdjNode** adjList = (AdjNode**)realloc(graph->adjList, newCapacity * sizeof(AdjNode*));
+    if (!adjList) return false;
+    graph->adjList = adjList;
+    
+    for (int i = graph->cityCapacity; i < newCapacity; i++) {
+        graph->adjList[i] = NULL;
+    }
+    graph->cityCapacity = newCapacity;
+    
+    // Keep the id table at most half full
+    return rebuildCityIndex(graph, 2 * newCapacity);
+}
+
+/**
+ * Rebuild adjacency lists from a bulk-loaded CSR snapshot (see loadGraphCSV)
+ * so the graph can be modified like any other
+ */
+static bool thawGraph(Graph* graph) {
+    const CSRGraph* csr = graph->frozen;
+    
+    for (int i = 0; i < csr->numCities; i++) {
+        // Lists grow by prepending; walk edges backwards to keep CSR order
+        for (int e = csr->offsets[i + 1] - 1; e >= csr->offsets[i]; e--) {
+            AdjNode* node = (AdjNode*)arenaAlloc(&graph->edgeArena, sizeof(AdjNode));
+            if (!node) {
+                fprintf(stderr, "Error: Memory allocation failed for adjacency lists\n");
+                for (int j = 0; j <= i; j++) {
+                    graph->adjList[j] = NULL;
+                }
+                return false;
+            }
+            node->cityIndex = csr->target[e];
+            node->distance = csr->distance[e];
+            node->time = csr->time[e];
+            node->cost = csr->cost[e];
+            node->modeId = csr->modeId[e];
+            node->next = graph->adjList[i];
+            graph->adjList[i] = node;
         }
     }
     
-    free(graph);
+    graph->edgesOnlyInCSR = false;
+    return true;
 }
 
 /**
  * Add a city to the graph
  */
 int addCity(Graph* graph, const char* id, const char* name, double lat, double lon) {
-    if (!graph || graph->numCities >= MAX_CITIES) {
+    if (!graph) {
+        return -1;
+    }
+    if (graph->mapping) {
+        fprintf(stderr, "Error: Graph loaded from a binary file is read-only\n");
         return -1;
     }
     
@@ -59,6 +206,18 @@ int addCity(Graph* graph, const char* id, const char* name, double lat, double l
         return -1;
     }
     
+    if (graph->numCities == graph->cityCapacity && !growCities(graph)) {
+        fprintf(stderr, "Error: Memory allocation failed for city storage\n");
+        return -1;
+    }
+    if (graph->edgesOnlyInCSR && !thawGraph(graph)) {
+        return -1;
+    }
+    
+    destroyCSRGraph(graph->frozen);
+    graph->frozen = NULL;
+    graph->version++;
+    
     int index = graph->numCities;
     strcpy(graph->cities[index].id, id);
     strcpy(graph->cities[index].name, name);
@@ -68,6 +227,7 @@ int addCity(Graph* graph, const char* id, const char* name, double lat, double l
     graph->cities[index].y = 0;
     
     graph->numCities++;
+    indexCity(graph, index);
     return index;
 }
 
@@ -77,6 +237,10 @@ int addCity(Graph* graph, const char* id, const char* name, double lat, double l
 int addRoute(Graph* graph, const char* from, const char* to, int distance,
              double time, int cost, const char* mode) {
     if (!graph) return -1;
+    if (graph->mapping) {
+        fprintf(stderr, "Error: Graph loaded from a binary file is read-only\n");
+        return -1;
+    }
     
     int fromIndex = findCityIndex(graph, from);
     int toIndex = findCityIndex(graph, to);
@@ -84,29 +248,42 @@ int addRoute(Graph* graph, const char* from, const char* to, int distance,
     if (fromIndex == -1 || toIndex == -1) {
         return -1;
     }
+    int modeId = internMode(graph, mode);
+    if (modeId == -1) {
+        fprintf(stderr, "Error: Transport mode '%s' is too long or more than %d modes are used\n",
+                mode, MAX_MODES);
+        return -1;
+    }
+    if (graph->edgesOnlyInCSR && !thawGraph(graph)) {
+        return -1;
+    }
+    
+    destroyCSRGraph(graph->frozen);
+    graph->frozen = NULL;
+    graph->version++;
     
     // Create new adjacency node
-    AdjNode* newNode = (AdjNode*)malloc(sizeof(AdjNode));
+    AdjNode* newNode = (AdjNode*)arenaAlloc(&graph->edgeArena, sizeof(AdjNode));
     if (!newNode) return -1;
     
     newNode->cityIndex = toIndex;
     newNode->distance = distance;
     newNode->time = time;
     newNode->cost = cost;
-    strcpy(newNode->mode, mode);
+    newNode->modeId = (unsigned char)modeId;
     newNode->next = graph->adjList[fromIndex];
     graph->adjList[fromIndex] = newNode;
     
     // If undirected, add reverse edge
     if (!graph->isDirected) {
-        AdjNode* reverseNode = (AdjNode*)malloc(sizeof(AdjNode));
+        AdjNode* reverseNode = (AdjNode*)arenaAlloc(&graph->edgeArena, sizeof(AdjNode));
         if (!reverseNode) return -1;
         
         reverseNode->cityIndex = fromIndex;
         reverseNode->distance = distance;
         reverseNode->time = time;
         reverseNode->cost = cost;
-        strcpy(reverseNode->mode, mode);
+        reverseNode->modeId = (unsigned char)modeId;
         reverseNode->next = graph->adjList[toIndex];
         graph->adjList[toIndex] = reverseNode;
     }
@@ -116,19 +293,166 @@ int addRoute(Graph* graph, const char* from, const char* to, int distance,
 }
 
 /**
- * Find city index by ID
+ * Weights the searches can use: none negative, and time in hundredths of an
+ * hour fits an int (NaN fails both comparisons)
  */
-int findCityIndex(Graph* graph, const char* id) {
+bool validRouteWeights(int distance, double time, int cost) {
+    return distance >= 0 && cost >= 0 && time >= 0 && time * 100 <= INT_MAX;
+}
+
+/**
+ * Change the weights of every from -> to route of the given mode in place
+ * (both directions on an undirected graph). The frozen snapshot is patched
+ * instead of rebuilt; the version still moves so landmarks and hierarchies
+ * go stale. Returns how many edges changed, -1 if there is no such route or
+ * the new weights fail validRouteWeights (nothing is changed then).
+ */
+int updateRoute(Graph* graph, const char* from, const char* to, const char* mode,
+                int newDistance, double newTime, int newCost) {
     if (!graph) return -1;
+    if (graph->mapping) {
+        fprintf(stderr, "Error: Graph loaded from a binary file is read-only\n");
+        return -1;
+    }
+    if (!validRouteWeights(newDistance, newTime, newCost)) {
+        fprintf(stderr, "Error: Route weights out of range\n");
+        return -1;
+    }
     
-    for (int i = 0; i < graph->numCities; i++) {
-        if (strcmp(graph->cities[i].id, id) == 0) {
+    int fromIndex = findCityIndex(graph, from);
+    int toIndex = findCityIndex(graph, to);
+    int modeId = findModeId(graph, mode);
+    if (fromIndex == -1 || toIndex == -1 || modeId == -1) {
+        return -1;
+    }
+    
+    int changed = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        int u = pass == 0 ? fromIndex : toIndex;
+        int v = pass == 0 ? toIndex : fromIndex;
+        if (pass == 1 && (graph->isDirected || u == v)) break;
+        
+        int listed = 0;
+        if (!graph->edgesOnlyInCSR) {
+            for (AdjNode* node = graph->adjList[u]; node; node = node->next) {
+                if (node->cityIndex != v || node->modeId != modeId) continue;
+                node->distance = newDistance;
+                node->time = newTime;
+                node->cost = newCost;
+                listed++;
+            }
+        }
+        
+        int patched = 0;
+        CSRGraph* csr = graph->frozen;
+        for (int e = csr ? csr->offsets[u] : 0; csr && e < csr->offsets[u + 1]; e++) {
+            if (csr->target[e] != v || csr->modeId[e] != modeId) continue;
+            csr->distance[e] = newDistance;
+            csr->time[e] = newTime;
+            csr->timeWeight[e] = (int)(newTime * 100); // Same scale as getWeight
+            csr->cost[e] = newCost;
+            patched++;
+        }
+        changed += graph->edgesOnlyInCSR ? patched : listed;
+    }
+    
+    if (changed == 0) return -1;
+    graph->version++;
+    return changed;
+}
+
+/**
+ * Find city index by ID (hash lookup, O(1) expected)
+ */
+int findCityIndex(Graph* graph, const char* id) {
+    if (!graph || !id) return -1;
+    
+    unsigned int mask = (unsigned int)graph->indexTableSize - 1;
+    unsigned int slot = hashCityId(id) & mask;
+    
+    while (graph->cityIndexTable[slot] != -1) {
+        int index = graph->cityIndexTable[slot];
+        if (strcmp(graph->cities[index].id, id) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+/**
+ * Mode id of a transport mode name, adding it if new.
+ * Returns -1 when the name does not fit or MAX_MODES are already in use.
+ */
+int internMode(Graph* graph, const char* mode) {
+    int modeId = findModeId(graph, mode);
+    if (modeId != -1) return modeId;
+    
+    if (graph->numModes >= MAX_MODES || strlen(mode) >= MAX_MODE_LENGTH) {
+        return -1;
+    }
+    strcpy(graph->modeNames[graph->numModes], mode);
+    return graph->numModes++;
+}
+
+/**
+ * Mode id of an existing transport mode name (-1 if unknown)
+ */
+int findModeId(const Graph* graph, const char* mode) {
+    for (int i = 0; i < graph->numModes; i++) {
+        if (strcmp(graph->modeNames[i], mode) == 0) {
             return i;
         }
     }
     return -1;
 }
 
+/**
+ * Parse an allowed-mode list such as "Train,Bus" (only those modes) or
+ * "-Flight" (every mode but those); names are separated by ',' or '+' and
+ * matched case-insensitively. "all" or an empty string allows every mode.
+ * Returns false on an unknown name.
+ */
+bool parseModeMask(const Graph* graph, const char* spec, ModeMask* mask) {
+    while (*spec == ' ') spec++;
+    if (*spec == '\0' || strcasecmp(spec, "all") == 0) {
+        *mask = MODE_MASK_ALL;
+        return true;
+    }
+    
+    bool exclude = *spec == '-';
+    if (exclude) spec++;
+    
+    ModeMask listed = 0;
+    while (*spec) {
+        const char* end = strpbrk(spec, ",+");
+        size_t length = end ? (size_t)(end - spec) : strlen(spec);
+        while (length > 0 && *spec == ' ') {
+            spec++;
+            length--;
+        }
+        while (length > 0 && (spec[length - 1] == ' ' || spec[length - 1] == '\n')) {
+            length--;
+        }
+        
+        int modeId = -1;
+        for (int i = 0; i < graph->numModes; i++) {
+            if (strlen(graph->modeNames[i]) == length &&
+                strncasecmp(graph->modeNames[i], spec, length) == 0) {
+                modeId = i;
+                break;
+            }
+        }
+        if (modeId == -1) return false;
+        listed |= modeBit(modeId);
+        if (!end) break;
+        spec = end + 1;
+    }
+    
+    *mask = exclude ? ~listed : listed;
+    return true;
+}
+
 /**
  * Print graph information
  */
@@ -145,18 +469,20 @@ void printGraph(Graph* graph) {
         printf("%d. %s (%s)\n", i + 1, graph->cities[i].name, graph->cities[i].id);
     }
     
+    // The CSR snapshot keeps adjacency-list order and also covers mapped graphs
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr) return;
+    
     printf("\nRoutes:\n");
-    for (int i = 0; i < graph->numCities; i++) {
-        AdjNode* node = graph->adjList[i];
-        while (node) {
+    for (int i = 0; i < csr->numCities; i++) {
+        for (int e = csr->offsets[i]; e < csr->offsets[i + 1]; e++) {
             printf("%s -> %s: %d km, %.1f hrs, Rs.%d (%s)\n",
                    graph->cities[i].name,
-                   graph->cities[node->cityIndex].name,
-                   node->distance,
-                   node->time,
-                   node->cost,
-                   node->mode);
-            node = node->next;
+                   graph->cities[csr->target[e]].name,
+                   csr->distance[e],
+                   csr->time[e],
+                   csr->cost[e],
+                   csr->modeNames[csr->modeId[e]]);
         }
     }
 }
@@ -175,6 +501,46 @@ int getEdgeCount(Graph* graph) {
     return graph ? graph->numRoutes : 0;
 }
 
+/**
+ * Print memory used by the graph, in total and per node / per edge
+ */
+void printMemoryUsage(Graph* graph) {
+    if (!graph) return;
+    
+    int n = graph->numCities;
+    long adjNodes = graph->isDirected ? graph->numRoutes : 2L * graph->numRoutes;
+    size_t cityBytes = (size_t)graph->cityCapacity * (sizeof(City) + sizeof(AdjNode*)) +
+                       (size_t)graph->indexTableSize * sizeof(int);
+    size_t edgeBytes = graph->edgeArena.bytesReserved;
+    size_t csrBytes = 0;
+    
+    if (graph->frozen) {
+        const CSRGraph* csr = graph->frozen;
+        csrBytes = sizeof(CSRGraph) + 2 * (size_t)(csr->numCities + 1) * sizeof(int) +
+                   3 * (size_t)csr->numCities * sizeof(double) +
+                   (size_t)csr->numEdges * (6 * sizeof(int) + sizeof(double) +
+                                            sizeof(unsigned char));
+    }
+    
+    printf("\n=== Memory Usage ===\n");
+    printf("City storage: %zu bytes (%d of %d slots used)\n", cityBytes, n, graph->cityCapacity);
+    printf("Adjacency lists: %zu bytes (%ld nodes in %d arena blocks)\n",
+           edgeBytes, adjNodes, graph->edgeArena.numBlocks);
+    if (graph->mapping) {
+        printf("CSR snapshot: %zu bytes, mapped from a %zu-byte graph file\n",
+               csrBytes, graph->mappingSize);
+    } else {
+        printf("CSR snapshot: %zu bytes\n", csrBytes);
+    }
+    if (n > 0) {
+        printf("Per node: %.1f bytes\n", (double)cityBytes / n);
+    }
+    if (adjNodes > 0) {
+        printf("Per edge: %.1f bytes list, %.1f bytes CSR\n",
+               (double)edgeBytes / adjNodes, (double)csrBytes / adjNodes);
+    }
+}
+
 /**
  * Get weight based on optimization type
  */
@@ -187,6 +553,18 @@ int getWeight(AdjNode* node, const char* weightType) {
     return node->distance; // Default: distance
 }
 
+/**
+ * Resolve an optimization type string ("distance" | "time" | "cost")
+ */
+WeightMetric parseWeightType(const char* weightType) {
+    if (weightType && strcmp(weightType, "time") == 0) {
+        return METRIC_TIME;
+    } else if (weightType && strcmp(weightType, "cost") == 0) {
+        return METRIC_COST;
+    }
+    return METRIC_DISTANCE; // Default: distance
+}
+
 /**
  * Calculate heuristic (straight-line distance) for A*
  */
@@ -202,7 +580,7 @@ double calculateHeuristic(Graph* graph, int fromIndex, int toIndex) {
     double a = sin(dlat/2) * sin(dlat/2) + 
                cos(lat1) * cos(lat2) * sin(dlon/2) * sin(dlon/2);
     double c = 2 * atan2(sqrt(a), sqrt(1-a));
-    double distance = 6371 * c; // Earth radius in km
+    double distance = EARTH_RADIUS_KM * c;
     
     return distance;
 }
@@ -236,23 +614,16 @@ void printPath(Graph* graph, PathResult* result) {
     for (int i = 0; i < result->pathLength - 1; i++) {
         int from = result->path[i];
         int to = result->path[i + 1];
+        const PathLeg* leg = &result->legs[i];
         
-        // Find the edge
-        AdjNode* node = graph->adjList[from];
-        while (node && node->cityIndex != to) {
-            node = node->next;
-        }
-        
-        if (node) {
-            printf("%d. %s -> %s: %d km, %.1f hrs, Rs.%d (%s)\n",
-                   i + 1,
-                   graph->cities[from].name,
-                   graph->cities[to].name,
-                   node->distance,
-                   node->time,
-                   node->cost,
-                   node->mode);
-        }
+        printf("%d. %s -> %s: %d km, %.1f hrs, Rs.%d (%s)\n",
+               i + 1,
+               graph->cities[from].name,
+               graph->cities[to].name,
+               leg->distance,
+               leg->time,
+               leg->cost,
+               leg->mode);
     }
 }
 
@@ -261,6 +632,8 @@ void printPath(Graph* graph, PathResult* result) {
  */
 void destroyPathResult(PathResult* result) {
     if (result) {
+        free(result->path);
+        free(result->legs);
         free(result);
     }
 }
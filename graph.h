@@ -12,11 +12,11 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <math.h>
+#include "arena.h"
 
-#define MAX_CITIES 50
-#define MAX_ROUTES 200
+#define INITIAL_CITY_CAPACITY 16
 #define MAX_NAME_LENGTH 50
-#define INFINITY_DIST 999999
+#define INFINITY_DIST INT_MAX
 
 // City structure
 typedef struct {
@@ -35,7 +35,7 @@ typedef struct {
     int distance;     // in km
     double time;      // in hours
     int cost;         // in rupees
-    char mode[20];    // Train, Bus, Flight
+    unsigned char modeId; // index into Graph.modeNames (Train, Bus, Flight)
 } Route;
 
 // Adjacency list node
@@ -44,22 +44,90 @@ typedef struct AdjNode {
     int distance;
     double time;
     int cost;
-    char mode[20];
+    unsigned char modeId;     // index into Graph.modeNames
     struct AdjNode* next;
 } AdjNode;
 
+#define MAX_MODES 16
+#define MAX_MODE_LENGTH 20
+#define EARTH_RADIUS_KM 6371.0
+
+// Optimization metric, resolved once per query from the weightType string
+typedef enum {
+    METRIC_DISTANCE,
+    METRIC_TIME,
+    METRIC_COST,
+    METRIC_COUNT
+} WeightMetric;
+
+// Set of allowed transport modes, bit i = mode id i (MAX_MODES <= 32)
+typedef unsigned int ModeMask;
+#define MODE_MASK_ALL 0xFFFFFFFFu
+
+static inline ModeMask modeBit(int modeId) {
+    return 1u << modeId;
+}
+
+// Immutable CSR snapshot of the adjacency lists used by the search kernels.
+// Edges of city i are [offsets[i], offsets[i+1]) in the per-edge arrays,
+// in the same order as adjList[i].
+typedef struct {
+    int numCities;
+    int numEdges;
+    int* offsets;             // numCities + 1 entries
+    int* target;              // destination city index
+    int* distance;            // in km
+    double* time;             // in hours
+    int* timeWeight;          // time in hundredths of an hour (search weight)
+    int* cost;                // in rupees
+    unsigned char* modeId;    // index into modeNames
+    int* revOffsets;          // incoming edges of city i: [revOffsets[i], revOffsets[i+1])
+    int* revSource;           // source city of each incoming edge
+    int* revEdge;             // forward edge id of each incoming edge
+    double* position;         // 3 per city: point on a sphere of EARTH_RADIUS_KM (x, y, z)
+    int numModes;
+    char modeNames[MAX_MODES][MAX_MODE_LENGTH];
+    bool external;            // arrays live in a mapped graph file, not owned (see graphfile.h)
+} CSRGraph;
+
+typedef struct QueryContext QueryContext;
+typedef struct LandmarkSet LandmarkSet;
+
 // Graph structure
 typedef struct {
-    City cities[MAX_CITIES];
-    AdjNode* adjList[MAX_CITIES];
+    City* cities;             // grows by doubling
+    AdjNode** adjList;        // same capacity as cities
+    int cityCapacity;
+    int* cityIndexTable;      // open-addressing hash of city id -> index, -1 = empty
+    int indexTableSize;       // power of two, kept at least twice cityCapacity
     int numCities;
     int numRoutes;
     bool isDirected;
+    unsigned long version;    // bumped by every addCity/addRoute/updateRoute
+    CSRGraph* frozen;         // cached snapshot, dropped by addCity/addRoute, patched by updateRoute
+    Arena edgeArena;          // owns every AdjNode
+    QueryContext* queryContext; // reused by dijkstra/aStar/bfs/dfs (see query.h)
+    QueryContext* reverseQueryContext; // backward half of bidirectionalDijkstra
+    LandmarkSet* landmarks[METRIC_COUNT]; // ALT tables for aStar (see alt.h), NULL until prepared
+    bool edgesOnlyInCSR;      // bulk-loaded routes live only in frozen until the first mutation
+    void* mapping;            // loadGraphBinary file mapping; cities, index and CSR point into it
+    size_t mappingSize;
+    int numModes;             // transport modes interned by addRoute, ids in order of first use
+    char modeNames[MAX_MODES][MAX_MODE_LENGTH];
 } Graph;
 
+// One hop of a path, copied from the exact edge the search used
+typedef struct {
+    int distance;
+    double time;
+    int cost;
+    char mode[MAX_MODE_LENGTH];
+} PathLeg;
+
 // Path result structure
 typedef struct {
-    int path[MAX_CITIES];
+    int* path;                // pathLength city indices, owned by the result
+    PathLeg* legs;            // pathLength - 1 hops, owned by the result
     int pathLength;
     int totalDistance;
     double totalTime;
@@ -75,20 +143,51 @@ void destroyGraph(Graph* graph);
 int addCity(Graph* graph, const char* id, const char* name, double lat, double lon);
 int addRoute(Graph* graph, const char* from, const char* to, int distance, 
              double time, int cost, const char* mode);
+int updateRoute(Graph* graph, const char* from, const char* to, const char* mode,
+                int newDistance, double newTime, int newCost);
+bool validRouteWeights(int distance, double time, int cost);
 int findCityIndex(Graph* graph, const char* id);
+int internMode(Graph* graph, const char* mode);
+int findModeId(const Graph* graph, const char* mode);
+bool parseModeMask(const Graph* graph, const char* spec, ModeMask* mask);
 void printGraph(Graph* graph);
 int getNodeCount(Graph* graph);
 int getEdgeCount(Graph* graph);
+void printMemoryUsage(Graph* graph);
+
+// CSR snapshot operations
+CSRGraph* freezeGraph(Graph* graph);
+CSRGraph* createCSRGraph(Graph* graph, int numEdges);
+bool buildReverseIndex(CSRGraph* csr);
+void destroyCSRGraph(CSRGraph* csr);
 
 // Algorithm functions
 PathResult* dijkstra(Graph* graph, const char* startId, const char* endId, const char* weightType);
 PathResult* aStar(Graph* graph, const char* startId, const char* endId, const char* weightType);
 PathResult* bfs(Graph* graph, const char* startId, const char* endId);
 PathResult* dfs(Graph* graph, const char* startId, const char* endId);
+PathResult* bidirectionalDijkstra(Graph* graph, const char* startId, const char* endId,
+                                  const char* weightType);
 
 // Helper functions
 double calculateHeuristic(Graph* graph, int fromIndex, int toIndex);
 int getWeight(AdjNode* node, const char* weightType);
+WeightMetric parseWeightType(const char* weightType);
+
+// Integer search weights of every CSR edge for one metric
+static inline const int* csrWeights(const CSRGraph* csr, WeightMetric metric) {
+    return metric == METRIC_TIME ? csr->timeWeight :
+           metric == METRIC_COST ? csr->cost : csr->distance;
+}
+
+// Straight-line (chord) km between two cities through the Earth: never more
+// than the great-circle distance, and needs no trig at query time
+static inline double chordDistance(const CSRGraph* csr, int fromIndex, int toIndex) {
+    const double* p = &csr->position[3 * fromIndex];
+    const double* q = &csr->position[3 * toIndex];
+    double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
 void printPath(Graph* graph, PathResult* result);
 void destroyPathResult(PathResult* result);
 
@@ -0,0 +1,329 @@
+/**
+ * Binary Graph File Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * saveGraphBinary writes the CSR snapshot, city table and id hash table.
+ * loadGraphBinary mmaps the file and builds a read-only Graph whose arrays
+ * point into the mapping instead of copying them. Every stored index is
+ * range-checked once at load, so a corrupt file is rejected rather than
+ * read out of bounds by the searches.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "graphfile.h"
+
+/**
+ * Round a file offset up to the section alignment
+ */
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + GRAPH_FILE_ALIGNMENT - 1) & ~(uint64_t)(GRAPH_FILE_ALIGNMENT - 1);
+}
+
+/**
+ * Zero-pad the stream up to offset
+ */
+static bool padTo(FILE* file, uint64_t* position, uint64_t offset) {
+    static const char zeros[GRAPH_FILE_ALIGNMENT] = {0};
+    size_t gap = (size_t)(offset - *position);
+    *position = offset;
+    return gap == 0 || fwrite(zeros, 1, gap, file) == gap;
+}
+
+/**
+ * Write graph (frozen first) to path in the binary graph format
+ */
+bool saveGraphBinary(Graph* graph, const char* path) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr) return false;
+    
+    int n = csr->numCities;
+    int m = csr->numEdges;
+    
+    char stringPool[MAX_MODES * MAX_MODE_LENGTH];
+    size_t poolSize = 0;
+    for (int i = 0; i < csr->numModes; i++) {
+        size_t length = strlen(csr->modeNames[i]) + 1;
+        memcpy(stringPool + poolSize, csr->modeNames[i], length);
+        poolSize += length;
+    }
+    
+    const void* data[SECTION_COUNT] = {
+        NULL, graph->cityIndexTable, csr->offsets, csr->target, csr->distance, csr->time,
+        csr->timeWeight, csr->cost, csr->modeId, csr->revOffsets, csr->revSource,
+        csr->revEdge, csr->position, stringPool
+    };
+    
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.headerSize = sizeof(GraphFileHeader);
+    header.citySize = sizeof(City);
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.numCities = n;
+    header.numRoutes = graph->numRoutes;
+    header.numEdges = m;
+    header.isDirected = graph->isDirected;
+    header.indexTableSize = graph->indexTableSize;
+    header.numModes = csr->numModes;
+    
+    header.sectionSize[SECTION_CITIES] = (uint64_t)n * sizeof(City);
+    header.sectionSize[SECTION_INDEX_TABLE] = (uint64_t)graph->indexTableSize * sizeof(int);
+    header.sectionSize[SECTION_OFFSETS] = (uint64_t)(n + 1) * sizeof(int);
+    header.sectionSize[SECTION_TARGET] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_DISTANCE] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_TIME] = (uint64_t)m * sizeof(double);
+    header.sectionSize[SECTION_TIME_WEIGHT] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_COST] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_MODE_ID] = (uint64_t)m * sizeof(unsigned char);
+    header.sectionSize[SECTION_REV_OFFSETS] = (uint64_t)(n + 1) * sizeof(int);
+    header.sectionSize[SECTION_REV_SOURCE] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_REV_EDGE] = (uint64_t)m * sizeof(int);
+    header.sectionSize[SECTION_POSITION] = (uint64_t)3 * n * sizeof(double);
+    header.sectionSize[SECTION_STRING_POOL] = poolSize;
+    
+    uint64_t offset = alignOffset(sizeof(GraphFileHeader));
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        header.sectionOffset[s] = offset;
+        offset = alignOffset(offset + header.sectionSize[s]);
+    }
+    header.fileSize = offset;
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open %s for writing\n", path);
+        return false;
+    }
+    
+    uint64_t position = sizeof(GraphFileHeader);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int s = 0; s < SECTION_COUNT && ok; s++) {
+        ok = padTo(file, &position, header.sectionOffset[s]);
+        if (s == SECTION_CITIES) {
+            // Copy field by field so padding and bytes after each NUL are zero
+            for (int i = 0; i < n && ok; i++) {
+                City city;
+                memset(&city, 0, sizeof(city));
+                strcpy(city.id, graph->cities[i].id);
+                strcpy(city.name, graph->cities[i].name);
+                city.latitude = graph->cities[i].latitude;
+                city.longitude = graph->cities[i].longitude;
+                city.x = graph->cities[i].x;
+                city.y = graph->cities[i].y;
+                ok = fwrite(&city, sizeof(city), 1, file) == 1;
+            }
+        } else if (header.sectionSize[s] > 0) {
+            ok = fwrite(data[s], 1, header.sectionSize[s], file) == header.sectionSize[s];
+        }
+        position += header.sectionSize[s];
+    }
+    ok = ok && padTo(file, &position, header.fileSize);
+    
+    if (fclose(file) != 0) ok = false;
+    if (!ok) fprintf(stderr, "Error: Failed writing %s\n", path);
+    return ok;
+}
+
+/**
+ * Check the header against the file and this build's layout
+ */
+static bool validateHeader(const GraphFileHeader* header, uint64_t fileSize) {
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != GRAPH_FILE_VERSION || header->headerSize != sizeof(GraphFileHeader) ||
+        header->citySize != sizeof(City) || header->byteOrder != GRAPH_FILE_BYTE_ORDER ||
+        header->fileSize != fileSize) {
+        return false;
+    }
+    
+    uint64_t n = header->numCities > 0 ? (uint64_t)header->numCities : 0;
+    uint64_t m = header->numEdges > 0 ? (uint64_t)header->numEdges : 0;
+    uint64_t tableSize = header->indexTableSize > 0 ? (uint64_t)header->indexTableSize : 0;
+    if (header->numCities < 0 || header->numEdges < 0 || header->numModes < 0 ||
+        header->numModes > MAX_MODES || tableSize < n + 1 || (tableSize & (tableSize - 1)) != 0) {
+        return false;
+    }
+    
+    uint64_t expected[SECTION_COUNT] = {
+        n * sizeof(City), tableSize * sizeof(int), (n + 1) * sizeof(int), m * sizeof(int),
+        m * sizeof(int), m * sizeof(double), m * sizeof(int), m * sizeof(int),
+        m * sizeof(unsigned char), (n + 1) * sizeof(int), m * sizeof(int), m * sizeof(int),
+        3 * n * sizeof(double), header->sectionSize[SECTION_STRING_POOL]
+    };
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        if (header->sectionSize[s] != expected[s] ||
+            header->sectionOffset[s] % GRAPH_FILE_ALIGNMENT != 0 ||
+            header->sectionOffset[s] > fileSize ||
+            header->sectionSize[s] > fileSize - header->sectionOffset[s]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Address of a section inside the mapping
+ */
+static void* sectionData(const char* base, const GraphFileHeader* header,
+                         GraphFileSection section) {
+    return (void*)(base + header->sectionOffset[section]);
+}
+
+/**
+ * offsets[0..n] runs from 0 to m without going down, and every value in
+ * values[0..m) lies in [0, limit)
+ */
+static bool validAdjacency(const int* offsets, int n, const int* values, int m, int limit) {
+    if (offsets[0] != 0 || offsets[n] != m) return false;
+    for (int i = 0; i < n; i++) {
+        if (offsets[i + 1] < offsets[i]) return false;
+    }
+    for (int e = 0; e < m; e++) {
+        if (values[e] < 0 || values[e] >= limit) return false;
+    }
+    return true;
+}
+
+/**
+ * Range-check every index the searches and findCityIndex follow: CSR
+ * offsets and edge ends, mode ids, the id hash table (which also needs a
+ * free slot to stop probing), NUL-terminated city strings and weights
+ */
+static bool validateSections(const char* base, const GraphFileHeader* header) {
+    int n = header->numCities;
+    int m = header->numEdges;
+    
+    const int* offsets = (const int*)sectionData(base, header, SECTION_OFFSETS);
+    const int* target = (const int*)sectionData(base, header, SECTION_TARGET);
+    const int* revOffsets = (const int*)sectionData(base, header, SECTION_REV_OFFSETS);
+    const int* revSource = (const int*)sectionData(base, header, SECTION_REV_SOURCE);
+    const int* revEdge = (const int*)sectionData(base, header, SECTION_REV_EDGE);
+    if (!validAdjacency(offsets, n, target, m, n) ||
+        !validAdjacency(revOffsets, n, revSource, m, n)) {
+        return false;
+    }
+    
+    // Searches also rely on weights never being negative
+    const unsigned char* modeId = (const unsigned char*)sectionData(base, header, SECTION_MODE_ID);
+    const int* distance = (const int*)sectionData(base, header, SECTION_DISTANCE);
+    const int* timeWeight = (const int*)sectionData(base, header, SECTION_TIME_WEIGHT);
+    const int* cost = (const int*)sectionData(base, header, SECTION_COST);
+    for (int e = 0; e < m; e++) {
+        if (revEdge[e] < 0 || revEdge[e] >= m || modeId[e] >= header->numModes ||
+            distance[e] < 0 || timeWeight[e] < 0 || cost[e] < 0) {
+            return false;
+        }
+    }
+    
+    const int* table = (const int*)sectionData(base, header, SECTION_INDEX_TABLE);
+    int used = 0;
+    for (int slot = 0; slot < header->indexTableSize; slot++) {
+        if (table[slot] == -1) continue;
+        if (table[slot] < 0 || table[slot] >= n || ++used > n) return false;
+    }
+    
+    const City* cities = (const City*)sectionData(base, header, SECTION_CITIES);
+    for (int i = 0; i < n; i++) {
+        if (!memchr(cities[i].id, '\0', sizeof(cities[i].id)) ||
+            !memchr(cities[i].name, '\0', sizeof(cities[i].name))) {
+            return false;
+        }
+    }
+    
+    // numModes names, each NUL-terminated inside the pool
+    const char* pool = (const char*)sectionData(base, header, SECTION_STRING_POOL);
+    const char* poolEnd = pool + header->sectionSize[SECTION_STRING_POOL];
+    for (int i = 0; i < header->numModes; i++) {
+        const char* end = (const char*)memchr(pool, '\0', (size_t)(poolEnd - pool));
+        if (!end) return false;
+        pool = end + 1;
+    }
+    return true;
+}
+
+/**
+ * Map a graph file and wrap it in a read-only Graph.
+ * Returns NULL if the file is missing, truncated or from another format version.
+ */
+Graph* loadGraphBinary(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return NULL;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(GraphFileHeader)) {
+        fprintf(stderr, "Error: %s is not a version %d graph file\n", path, GRAPH_FILE_VERSION);
+        close(fd);
+        return NULL;
+    }
+    void* mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map %s\n", path);
+        return NULL;
+    }
+    
+    const char* base = (const char*)mapping;
+    const GraphFileHeader* header = (const GraphFileHeader*)base;
+    bool valid = validateHeader(header, (uint64_t)info.st_size) && validateSections(base, header);
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a version %d graph file\n", path, GRAPH_FILE_VERSION);
+        munmap(mapping, (size_t)info.st_size);
+        return NULL;
+    }
+    
+    Graph* graph = (Graph*)calloc(1, sizeof(Graph));
+    CSRGraph* csr = (CSRGraph*)calloc(1, sizeof(CSRGraph));
+    if (!graph || !csr) {
+        fprintf(stderr, "Error: Memory allocation failed for graph\n");
+        free(graph);
+        free(csr);
+        munmap(mapping, (size_t)info.st_size);
+        return NULL;
+    }
+    
+    csr->numCities = header->numCities;
+    csr->numEdges = header->numEdges;
+    csr->offsets = (int*)sectionData(base, header, SECTION_OFFSETS);
+    csr->target = (int*)sectionData(base, header, SECTION_TARGET);
+    csr->distance = (int*)sectionData(base, header, SECTION_DISTANCE);
+    csr->time = (double*)sectionData(base, header, SECTION_TIME);
+    csr->timeWeight = (int*)sectionData(base, header, SECTION_TIME_WEIGHT);
+    csr->cost = (int*)sectionData(base, header, SECTION_COST);
+    csr->modeId = (unsigned char*)sectionData(base, header, SECTION_MODE_ID);
+    csr->revOffsets = (int*)sectionData(base, header, SECTION_REV_OFFSETS);
+    csr->revSource = (int*)sectionData(base, header, SECTION_REV_SOURCE);
+    csr->revEdge = (int*)sectionData(base, header, SECTION_REV_EDGE);
+    csr->position = (double*)sectionData(base, header, SECTION_POSITION);
+    csr->external = true;
+    
+    const char* pool = (const char*)sectionData(base, header, SECTION_STRING_POOL);
+    const char* poolEnd = pool + header->sectionSize[SECTION_STRING_POOL];
+    for (int i = 0; i < header->numModes; i++) {
+        // validateSections found a NUL for each name
+        snprintf(csr->modeNames[i], sizeof(csr->modeNames[i]), "%s", pool);
+        pool = (const char*)memchr(pool, '\0', (size_t)(poolEnd - pool)) + 1;
+        csr->numModes++;
+    }
+    graph->numModes = csr->numModes;
+    memcpy(graph->modeNames, csr->modeNames, sizeof(graph->modeNames));
+    
+    graph->cities = (City*)sectionData(base, header, SECTION_CITIES);
+    graph->adjList = NULL;
+    graph->cityCapacity = header->numCities;
+    graph->cityIndexTable = (int*)sectionData(base, header, SECTION_INDEX_TABLE);
+    graph->indexTableSize = header->indexTableSize;
+    graph->numCities = header->numCities;
+    graph->numRoutes = header->numRoutes;
+    graph->isDirected = header->isDirected != 0;
+    graph->frozen = csr;
+    graph->mapping = mapping;
+    graph->mappingSize = (size_t)info.st_size;
+    arenaInit(&graph->edgeArena);
+    
+    return graph;
+}
@@ -0,0 +1,59 @@
+/**
+ * Binary Graph File Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef GRAPHFILE_H
+#define GRAPHFILE_H
+
+#include <stdint.h>
+#include "graph.h"
+
+#define GRAPH_FILE_MAGIC "TRPGRAPH"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_ALIGNMENT 64
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+
+// Sections of a graph file, each starting on a GRAPH_FILE_ALIGNMENT boundary
+typedef enum {
+    SECTION_CITIES,           // City records, numCities
+    SECTION_INDEX_TABLE,      // int city id hash table, indexTableSize (see findCityIndex)
+    SECTION_OFFSETS,          // int, numCities + 1
+    SECTION_TARGET,           // int, numEdges
+    SECTION_DISTANCE,         // int, numEdges
+    SECTION_TIME,             // double, numEdges
+    SECTION_TIME_WEIGHT,      // int, numEdges
+    SECTION_COST,             // int, numEdges
+    SECTION_MODE_ID,          // unsigned char, numEdges
+    SECTION_REV_OFFSETS,      // int, numCities + 1
+    SECTION_REV_SOURCE,       // int, numEdges
+    SECTION_REV_EDGE,         // int, numEdges
+    SECTION_POSITION,         // double, 3 * numCities
+    SECTION_STRING_POOL,      // numModes NUL-terminated mode names
+    SECTION_COUNT
+} GraphFileSection;
+
+// Fixed-size file header. The arrays are the CSRGraph arrays byte for byte,
+// so a loaded graph points straight into the mapping. citySize and
+// byteOrder reject files written by an incompatible build.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t citySize;
+    uint32_t byteOrder;
+    int32_t numCities;
+    int32_t numRoutes;
+    int32_t numEdges;
+    int32_t isDirected;
+    int32_t indexTableSize;
+    int32_t numModes;
+    uint64_t fileSize;
+    uint64_t sectionOffset[SECTION_COUNT];
+    uint64_t sectionSize[SECTION_COUNT];
+} GraphFileHeader;
+
+bool saveGraphBinary(Graph* graph, const char* path);
+Graph* loadGraphBinary(const char* path);
+
+#endif // GRAPHFILE_H
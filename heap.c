@@ -0,0 +1,174 @@
+/**
+ * Indexed Min-Heap Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Contiguous d-ary heap used as the priority queue for Dijkstra and A*.
+ * Each city appears at most once; a better priority moves it up in place.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "heap.h"
+
+/**
+ * Create a heap able to hold every city index in [0, capacity)
+ */
+MinHeap* createMinHeap(int capacity) {
+    MinHeap* heap = (MinHeap*)malloc(sizeof(MinHeap));
+    if (!heap) {
+        fprintf(stderr, "Error: Memory allocation failed for heap\n");
+        return NULL;
+    }
+    
+    heap->entries = (HeapEntry*)malloc((capacity > 0 ? capacity : 1) * sizeof(HeapEntry));
+    heap->position = (int*)malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    if (!heap->entries || !heap->position) {
+        fprintf(stderr, "Error: Memory allocation failed for heap\n");
+        free(heap->entries);
+        free(heap->position);
+        free(heap);
+        return NULL;
+    }
+    
+    for (int i = 0; i < capacity; i++) {
+        heap->position[i] = -1;
+    }
+    heap->size = 0;
+    heap->capacity = capacity;
+    return heap;
+}
+
+/**
+ * Set up a heap over caller-owned arrays (not freed by destroyMinHeap)
+ */
+void initMinHeap(MinHeap* heap, HeapEntry* entries, int* position, int capacity) {
+    heap->entries = entries;
+    heap->position = position;
+    heap->size = 0;
+    heap->capacity = capacity;
+    
+    for (int i = 0; i < capacity; i++) {
+        position[i] = -1;
+    }
+}
+
+/**
+ * Destroy heap and free memory
+ */
+void destroyMinHeap(MinHeap* heap) {
+    if (!heap) return;
+    free(heap->entries);
+    free(heap->position);
+    free(heap);
+}
+
+static void siftUp(MinHeap* heap, int slot) {
+    HeapEntry moving = heap->entries[slot];
+    
+    while (slot > 0) {
+        int parentSlot = (slot - 1) / HEAP_ARITY;
+        HeapEntry parent = heap->entries[parentSlot];
+        if (parent.priority <= moving.priority) break;
+        
+        heap->entries[slot] = parent;
+        heap->position[parent.cityIndex] = slot;
+        slot = parentSlot;
+    }
+    
+    heap->entries[slot] = moving;
+    heap->position[moving.cityIndex] = slot;
+}
+
+static void siftDown(MinHeap* heap, int slot) {
+    HeapEntry moving = heap->entries[slot];
+    
+    while (true) {
+        int firstChild = slot * HEAP_ARITY + 1;
+        if (firstChild >= heap->size) break;
+        
+        int lastChild = firstChild + HEAP_ARITY;
+        if (lastChild > heap->size) lastChild = heap->size;
+        
+        int best = firstChild;
+        for (int c = firstChild + 1; c < lastChild; c++) {
+            if (heap->entries[c].priority < heap->entries[best].priority) {
+                best = c;
+            }
+        }
+        if (heap->entries[best].priority >= moving.priority) break;
+        
+        heap->entries[slot] = heap->entries[best];
+        heap->position[heap->entries[slot].cityIndex] = slot;
+        slot = best;
+    }
+    
+    heap->entries[slot] = moving;
+    heap->position[moving.cityIndex] = slot;
+}
+
+/**
+ * Insert a city, or lower its priority if it is already queued.
+ * A priority that is not an improvement is ignored.
+ */
+void heapPushOrDecrease(MinHeap* heap, int cityIndex, int priority) {
+    int slot = heap->position[cityIndex];
+    
+    if (slot == -1) {
+        slot = heap->size++;
+        heap->entries[slot].cityIndex = cityIndex;
+        heap->entries[slot].priority = priority;
+        siftUp(heap, slot);
+    } else if (priority < heap->entries[slot].priority) {
+        heap->entries[slot].priority = priority;
+        siftUp(heap, slot);
+    }
+}
+
+/**
+ * Set a city's priority in either direction, inserting it if absent
+ */
+void heapUpdatePriority(MinHeap* heap, int cityIndex, int priority) {
+    int slot = heap->position[cityIndex];
+    
+    if (slot == -1 || priority < heap->entries[slot].priority) {
+        heapPushOrDecrease(heap, cityIndex, priority);
+    } else if (priority > heap->entries[slot].priority) {
+        heap->entries[slot].priority = priority;
+        siftDown(heap, slot);
+    }
+}
+
+/**
+ * Remove and return the city with the smallest priority (-1 if empty)
+ */
+int heapPopMin(MinHeap* heap) {
+    if (heap->size == 0) return -1;
+    
+    int cityIndex = heap->entries[0].cityIndex;
+    heap->position[cityIndex] = -1;
+    heap->size--;
+    
+    if (heap->size > 0) {
+        heap->entries[0] = heap->entries[heap->size];
+        siftDown(heap, 0);
+    }
+    
+    return cityIndex;
+}
+
+/**
+ * Check whether a city is currently queued
+ */
+bool heapContains(const MinHeap* heap, int cityIndex) {
+    return heap->position[cityIndex] != -1;
+}
+
+/**
+ * Empty the heap in O(size) so it can be reused for another query
+ */
+void heapClear(MinHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        heap->position[heap->entries[i].cityIndex] = -1;
+    }
+    heap->size = 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * Indexed Min-Heap Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdbool.h>
+
+// Children per heap node (4-ary keeps sift-down within one or two cache lines)
+#define HEAP_ARITY 4
+
+// Heap slot: priority stored next to the city it belongs to
+typedef struct {
+    int priority;
+    int cityIndex;
+} HeapEntry;
+
+// Indexed min-heap with decrease-key, sized once for all cities of a graph
+typedef struct {
+    HeapEntry* entries;
+    int* position;      // position[city] = slot in entries, -1 if not queued
+    int size;
+    int capacity;
+} MinHeap;
+
+MinHeap* createMinHeap(int capacity);
+void initMinHeap(MinHeap* heap, HeapEntry* entries, int* position, int capacity);
+void destroyMinHeap(MinHeap* heap);
+void heapPushOrDecrease(MinHeap* heap, int cityIndex, int priority);
+void heapUpdatePriority(MinHeap* heap, int cityIndex, int priority);
+int heapPopMin(MinHeap* heap);
+bool heapContains(const MinHeap* heap, int cityIndex);
+void heapClear(MinHeap* heap);
+
+static inline bool heapIsEmpty(const MinHeap* heap) {
+    return heap->size == 0;
+}
+
+static inline int heapMinPriority(const MinHeap* heap) {
+    return heap->entries[0].priority;
+}
+
+#endif // HEAP_H
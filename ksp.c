@@ -0,0 +1,351 @@
+/**
+ * K-Shortest Paths Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Yen's algorithm: route j + 1 is the cheapest deviation from one of the
+ * first j routes. Each accepted route is split at every city (the spur
+ * node); a spur search finds the cheapest way on to end that avoids the
+ * cities of the root path before the spur node and the edges that accepted
+ * routes with the same root took next.
+ *
+ * One backward Dijkstra from end gives every city its exact distance to end
+ * and the shortest-path tree that realizes it. Spur searches are A* on that
+ * exact bound and stop at the first settled city whose tree path to end
+ * touches nothing blocked, finishing the route along the tree. Spur nodes
+ * before a route's own deviation point are skipped (Lawler), only the
+ * k - accepted cheapest candidates are kept, and a spur search gives up as
+ * soon as it cannot beat the last of them.
+ */
+
+#include "ksp.h"
+
+// One route as a run of CSR edge ids in the edge pool
+typedef struct {
+    int weight;
+    int numEdges;
+    int offset;               // first edge in YenSearch.pool
+    int deviation;            // edge index where it left the route it was spurred from
+} KPath;
+
+typedef struct {
+    const CSRGraph* csr;
+    const int* weights;
+    QueryContext* ctx;        // spur searches
+    QueryContext* tree;       // backward shortest-path tree to end
+    int end;
+    int* pool;                // edges of every kept route
+    int poolSize;
+    int poolCapacity;
+    KPath* accepted;          // ranked routes so far
+    int numAccepted;
+    KPath* candidates;        // cheapest routes not yet accepted, sorted
+    int numCandidates;
+    int* blockedEdges;        // edges out of the current spur node taken by accepted routes
+    unsigned int* blocked;    // == blockGeneration: city is on the current root path
+    unsigned int blockGeneration;
+    int numSpurSearches;
+} YenSearch;
+
+/**
+ * Make room for count more edges in the pool
+ */
+static bool reservePool(YenSearch* search, int count) {
+    if (search->poolSize + count <= search->poolCapacity) return true;
+    
+    int newCapacity = search->poolCapacity > 0 ? search->poolCapacity : 256;
+    while (newCapacity < search->poolSize + count) {
+        newCapacity *= 2;
+    }
+    int* grown = (int*)realloc(search->pool, (size_t)newCapacity * sizeof(int));
+    if (!grown) {
+        fprintf(stderr, "Error: Memory allocation failed for k-shortest paths\n");
+        return false;
+    }
+    search->pool = grown;
+    search->poolCapacity = newCapacity;
+    return true;
+}
+
+/**
+ * Ranking order: weight, then fewer legs
+ */
+static inline bool pathLess(const KPath* a, const KPath* b) {
+    return a->weight < b->weight || (a->weight == b->weight && a->numEdges < b->numEdges);
+}
+
+/**
+ * A route of this weight and at least minLegs legs would rank at or past
+ * last, the last candidate still needed (NULL while there is room)
+ */
+static inline bool cannotBeat(const KPath* last, int weight, int minLegs) {
+    return last && (weight > last->weight || (weight == last->weight && minLegs >= last->numEdges));
+}
+
+/**
+ * Insert a route into the sorted candidates unless it is a duplicate or
+ * falls past the `needed` cheapest. Returns true if it was kept.
+ */
+static bool addCandidate(YenSearch* search, const KPath* route, int needed) {
+    int pos = search->numCandidates;
+    while (pos > 0 && pathLess(route, &search->candidates[pos - 1])) {
+        pos--;
+    }
+    if (pos >= needed) return false;
+    
+    // Equal routes sort next to each other, just before pos
+    for (int i = pos - 1; i >= 0 && !pathLess(&search->candidates[i], route); i--) {
+        if (memcmp(&search->pool[search->candidates[i].offset], &search->pool[route->offset],
+                   route->numEdges * sizeof(int)) == 0) {
+            return false;
+        }
+    }
+    
+    int count = search->numCandidates < needed ? search->numCandidates : needed - 1;
+    memmove(&search->candidates[pos + 1], &search->candidates[pos],
+            (count - pos) * sizeof(KPath));
+    search->candidates[pos] = *route;
+    search->numCandidates = count + 1;
+    return true;
+}
+
+/**
+ * The tree path from city to end avoids the root path and the blocked
+ * edges out of spur
+ */
+static bool treePathClear(const YenSearch* search, int city, int spur, int numBlockedEdges) {
+    const QueryContext* tree = search->tree;
+    
+    for (; city != search->end; city = tree->parent[city]) {
+        if (city == spur) {
+            for (int i = 0; i < numBlockedEdges; i++) {
+                if (search->blockedEdges[i] == tree->parentEdge[city]) return false;
+            }
+        }
+        if (search->blocked[tree->parent[city]] == search->blockGeneration) return false;
+    }
+    return true;
+}
+
+static inline bool edgeBlocked(const YenSearch* search, int e, int numBlockedEdges) {
+    for (int i = 0; i < numBlockedEdges; i++) {
+        if (search->blockedEdges[i] == e) return true;
+    }
+    return false;
+}
+
+/**
+ * Spur at edge index `index` of path (its first index edges are the root;
+ * NULL for the first route): find the cheapest way on to end and keep it
+ * as a candidate if it is among the cheapest still needed.
+ * Returns false on allocation failure.
+ */
+static bool spurFrom(YenSearch* search, int start, const KPath* path, int index, int k) {
+    const CSRGraph* csr = search->csr;
+    const QueryContext* tree = search->tree;
+    QueryContext* ctx = search->ctx;
+    int needed = k - search->numAccepted;
+    const KPath* last = search->numCandidates == needed ? &search->candidates[needed - 1] : NULL;
+    
+    // Block the root path's cities and weigh it
+    if (++search->blockGeneration == 0) {
+        memset(search->blocked, 0, csr->numCities * sizeof(unsigned int));
+        search->blockGeneration = 1;
+    }
+    int spur = start;
+    int rootWeight = 0;
+    for (int i = 0; i < index; i++) {
+        int e = search->pool[path->offset + i];
+        search->blocked[spur] = search->blockGeneration;
+        rootWeight += search->weights[e];
+        spur = csr->target[e];
+    }
+    int bound = queryDistance(tree, spur);
+    // Every route from here has the root's index legs and at least one more
+    if (bound == INFINITY_DIST || cannotBeat(last, rootWeight + bound, index + 1)) return true;
+    
+    int numBlockedEdges = 0;
+    for (int a = 0; path && a < search->numAccepted; a++) {
+        const KPath* other = &search->accepted[a];
+        if (other->numEdges > index &&
+            memcmp(&search->pool[other->offset], &search->pool[path->offset],
+                   index * sizeof(int)) == 0) {
+            search->blockedEdges[numBlockedEdges++] = search->pool[other->offset + index];
+        }
+    }
+    
+    // A* on the exact tree bound: f never drops, so the first clear city is optimal
+    search->numSpurSearches++;
+    beginQuery(ctx, csr->numCities);
+    touchCity(ctx, spur);
+    ctx->dist[spur] = 0;
+    heapPushOrDecrease(&ctx->heap, spur, bound);
+    
+    int reached = -1;
+    while (!heapIsEmpty(&ctx->heap)) {
+        int city = heapPopMin(&ctx->heap);
+        if (isVisited(ctx, city)) continue;
+        markVisited(ctx, city);
+        
+        int estimate = rootWeight + ctx->dist[city] + queryDistance(tree, city);
+        if (cannotBeat(last, estimate, index + 1)) break;
+        if (treePathClear(search, city, spur, numBlockedEdges)) {
+            reached = city;
+            break;
+        }
+        
+        for (int e = csr->offsets[city]; e < csr->offsets[city + 1]; e++) {
+            int next = csr->target[e];
+            if (search->blocked[next] == search->blockGeneration || isVisited(ctx, next)) continue;
+            if (city == spur && edgeBlocked(search, e, numBlockedEdges)) continue;
+            int nextBound = queryDistance(tree, next);
+            if (nextBound == INFINITY_DIST) continue;
+            
+            int g = ctx->dist[city] + search->weights[e];
+            touchCity(ctx, next);
+            if (g < ctx->dist[next]) {
+                ctx->dist[next] = g;
+                ctx->parent[next] = city;
+                ctx->parentEdge[next] = e;
+                heapPushOrDecrease(&ctx->heap, next, g + nextBound);
+            }
+        }
+    }
+    if (reached == -1) return true;
+    
+    // Route = root + search chain spur..reached + tree path reached..end
+    int chain = 0, tail = 0;
+    for (int city = reached; city != spur; city = ctx->parent[city]) {
+        chain++;
+    }
+    for (int city = reached; city != search->end; city = tree->parent[city]) {
+        tail++;
+    }
+    KPath route = {rootWeight + ctx->dist[reached] + queryDistance(tree, reached),
+                   index + chain + tail, search->poolSize, index};
+    if (!reservePool(search, route.numEdges)) return false;
+    
+    int* edges = &search->pool[route.offset];
+    if (index > 0) {
+        memcpy(edges, &search->pool[path->offset], index * sizeof(int));
+    }
+    int i = index + chain;
+    for (int city = reached; city != spur; city = ctx->parent[city]) {
+        edges[--i] = ctx->parentEdge[city];
+    }
+    i = index + chain;
+    for (int city = reached; city != search->end; city = tree->parent[city]) {
+        edges[i++] = tree->parentEdge[city];
+    }
+    
+    if (addCandidate(search, &route, needed)) {
+        search->poolSize += route.numEdges;
+    }
+    return true;
+}
+
+static void freeSearch(YenSearch* search) {
+    free(search->pool);
+    free(search->accepted);
+    free(search->candidates);
+    free(search->blockedEdges);
+    free(search->blocked);
+}
+
+/**
+ * Up to k loopless routes from start to end, cheapest first on metric.
+ * ctx runs the spur searches and tree holds the backward shortest-path tree
+ * (two distinct contexts). Returns NULL on invalid input or allocation
+ * failure; an unreachable end gives an empty set.
+ */
+RankedPaths* kShortestPathsQuery(Graph* graph, QueryContext* ctx, QueryContext* tree,
+                                 int start, int end, WeightMetric metric, int k) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || k <= 0 || ctx == tree || start < 0 || end < 0 ||
+        start >= csr->numCities || end >= csr->numCities) {
+        return NULL;
+    }
+    
+    int n = csr->numCities;
+    YenSearch search;
+    memset(&search, 0, sizeof(search));
+    search.csr = csr;
+    search.weights = csrWeights(csr, metric);
+    search.ctx = ctx;
+    search.tree = tree;
+    search.end = end;
+    search.accepted = (KPath*)malloc(k * sizeof(KPath));
+    search.candidates = (KPath*)malloc(k * sizeof(KPath));
+    search.blockedEdges = (int*)malloc(k * sizeof(int));
+    search.blocked = (unsigned int*)calloc(n, sizeof(unsigned int));
+    RankedPaths* paths = (RankedPaths*)calloc(1, sizeof(RankedPaths));
+    bool ok = paths && search.accepted && search.candidates && search.blockedEdges &&
+              search.blocked && beginQuery(ctx, n) &&
+              dijkstraOneToAll(graph, tree, end, metric, true);
+    
+    // The first route is the tree path from start
+    if (ok) ok = spurFrom(&search, start, NULL, 0, k);
+    
+    while (ok && search.numCandidates > 0) {
+        KPath* route = &search.accepted[search.numAccepted++];
+        *route = search.candidates[0];
+        search.numCandidates--;
+        memmove(&search.candidates[0], &search.candidates[1],
+                search.numCandidates * sizeof(KPath));
+        if (search.numAccepted == k) break;
+        
+        for (int i = route->deviation; ok && i < route->numEdges; i++) {
+            ok = spurFrom(&search, start, route, i, k);
+        }
+    }
+    
+    if (ok) {
+        int count = search.numAccepted > 0 ? search.numAccepted : 1;
+        paths->results = (PathResult**)malloc(count * sizeof(PathResult*));
+        paths->weights = (int*)malloc(count * sizeof(int));
+        paths->numSpurSearches = search.numSpurSearches;
+        ok = paths->results && paths->weights;
+        for (int i = 0; ok && i < search.numAccepted; i++) {
+            const KPath* route = &search.accepted[i];
+            paths->results[i] = buildPathFromEdges(csr, start, &search.pool[route->offset],
+                                                   route->numEdges, "Yen's K-Shortest Paths");
+            paths->weights[i] = route->weight;
+            ok = paths->results[i] != NULL;
+            if (ok) paths->numResults++;
+        }
+    }
+    
+    freeSearch(&search);
+    if (!ok) {
+        destroyRankedPaths(paths);
+        return NULL;
+    }
+    return paths;
+}
+
+RankedPaths* kShortestPaths(Graph* graph, const char* startId, const char* endId,
+                            const char* weightType, int k) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
+    
+    if (start == -1 || end == -1) {
+        return NULL;
+    }
+    
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    QueryContext* tree = getGraphQueryContext(graph, true);
+    if (!ctx || !tree) return NULL;
+    return kShortestPathsQuery(graph, ctx, tree, start, end, parseWeightType(weightType), k);
+}
+
+/**
+ * Destroy a ranked set and every route in it
+ */
+void destroyRankedPaths(RankedPaths* paths) {
+    if (!paths) return;
+    for (int i = 0; i < paths->numResults; i++) {
+        destroyPathResult(paths->results[i]);
+    }
+    free(paths->results);
+    free(paths->weights);
+    free(paths);
+}
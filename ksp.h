@@ -0,0 +1,29 @@
+/**
+ * K-Shortest Paths Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef KSP_H
+#define KSP_H
+
+#include "graph.h"
+#include "query.h"
+
+// Up to k loopless routes from start to end, cheapest first on the chosen
+// metric. Fewer than k when no more routes exist. Equal-weight candidates
+// rank fewer legs first, but each spur search yields one cheapest route, so
+// a longer one found earlier (the first route included) keeps its place.
+typedef struct {
+    int numResults;
+    PathResult** results;
+    int* weights;             // search weight of each route (time in hundredths of an hour)
+    int numSpurSearches;      // spur searches run; the rest were pruned by the bound
+} RankedPaths;
+
+RankedPaths* kShortestPaths(Graph* graph, const char* startId, const char* endId,
+                            const char* weightType, int k);
+RankedPaths* kShortestPathsQuery(Graph* graph, QueryContext* ctx, QueryContext* tree,
+                                 int start, int end, WeightMetric metric, int k);
+void destroyRankedPaths(RankedPaths* paths);
+
+#endif // KSP_H
@@ -0,0 +1,514 @@
+/**
+ * CSV Graph Loader Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * cities.csv: id,name,lat,lon       routes.csv: from,to,distance,time,cost,mode
+ *
+ * Files are streamed in CSV_CHUNK_SIZE pieces, so memory use does not grow
+ * with file size. Routes bypass addRoute: the file is split into byte
+ * ranges, one per thread, and read twice. Pass 1 validates every line,
+ * resolves its city ids and counts each city's edges; pass 2 writes every
+ * edge straight into its final CSR slot. Peak memory is the finished CSR
+ * plus the resolved endpoints (8 bytes per line), one degree array and one
+ * chunk per thread.
+ */
+
+#include <pthread.h>
+#include "loader.h"
+#include "matrix.h"
+
+// Line-at-a-time view of a byte range of a file, refilled chunk by chunk
+typedef struct {
+    FILE* file;
+    char* buffer;             // CSV_CHUNK_SIZE + 1 bytes
+    size_t length;            // valid bytes in buffer
+    size_t position;          // first unread byte
+    long bufferOffset;        // file offset of buffer[0]
+    bool eof;
+} ChunkReader;
+
+typedef struct RouteWorker RouteWorker;
+
+// State shared by every route worker
+typedef struct {
+    Graph* graph;
+    CSRGraph* csr;
+    const char* path;
+    bool isDirected;
+    bool fillPass;            // false: count degrees, true: write edges
+} RouteLoad;
+
+struct RouteWorker {
+    RouteLoad* load;
+    long start;               // handles lines that begin in [start, end)
+    long end;
+    int* degree;              // pass 1: edges per city, pass 2: next free slot per city
+    int* endpoints;           // from, to per non-empty line; from -1 for a bad line
+    long numLines;
+    long lineCapacity;
+    long loaded;
+    long skipped;
+    bool failed;
+    int numModes;             // modes in order of first use in this range
+    char modes[MAX_MODES][MAX_MODE_LENGTH];
+    int modeIds[MAX_MODES];   // global ids, set between the passes
+};
+
+/**
+ * Open a reader positioned at the first line that begins at or after start
+ */
+static bool openChunkReader(ChunkReader* reader, const char* path, long start) {
+    reader->file = fopen(path, "rb");
+    reader->buffer = (char*)malloc(CSV_CHUNK_SIZE + 1);
+    reader->length = 0;
+    reader->position = 0;
+    reader->bufferOffset = start > 0 ? start - 1 : 0;
+    reader->eof = false;
+    if (!reader->file || !reader->buffer) {
+        if (reader->file) fclose(reader->file);
+        free(reader->buffer);
+        return false;
+    }
+    if (start == 0) return true;
+    
+    // Back up one byte: if it is '\n', a line begins exactly at start
+    if (fseek(reader->file, start - 1, SEEK_SET) != 0) {
+        reader->eof = true;
+        return true;
+    }
+    int c;
+    while ((c = fgetc(reader->file)) != EOF && c != '\n') {
+        reader->bufferOffset++;
+    }
+    reader->bufferOffset++;
+    reader->eof = c == EOF;
+    return true;
+}
+
+static void closeChunkReader(ChunkReader* reader) {
+    fclose(reader->file);
+    free(reader->buffer);
+}
+
+/**
+ * Next line without its line ending, NUL-terminated in place; *lineStart
+ * receives its file offset. Returns NULL at end of file. A line longer
+ * than the chunk is returned cut at the chunk size (and fails to parse).
+ */
+static char* nextLine(ChunkReader* reader, long* lineStart) {
+    while (true) {
+        char* begin = reader->buffer + reader->position;
+        size_t available = reader->length - reader->position;
+        char* newline = (char*)memchr(begin, '\n', available);
+        
+        if (newline || (reader->eof && available > 0) ||
+            (available == CSV_CHUNK_SIZE)) {
+            char* stop = newline ? newline : begin + available;
+            *lineStart = reader->bufferOffset + (long)reader->position;
+            reader->position = (size_t)(stop - reader->buffer) + (newline ? 1 : 0);
+            if (stop > begin && stop[-1] == '\r') stop--;
+            *stop = '\0';
+            return begin;
+        }
+        if (reader->eof) return NULL;
+        
+        // Keep the partial line, refill behind it
+        memmove(reader->buffer, begin, available);
+        reader->bufferOffset += (long)reader->position;
+        reader->position = 0;
+        reader->length = available;
+        size_t got = fread(reader->buffer + available, 1, CSV_CHUNK_SIZE - available,
+                           reader->file);
+        reader->length += got;
+        if (got < CSV_CHUNK_SIZE - available) reader->eof = true;
+    }
+}
+
+/**
+ * Split a line on commas in place. Fields may be double-quoted, with ""
+ * for a literal quote. Returns the number of fields, at most maxFields + 1
+ * so callers can reject extra columns.
+ */
+static int splitFields(char* line, char** fields, int maxFields) {
+    int count = 0;
+    char* p = line;
+    
+    while (true) {
+        char* field = p;
+        if (*p == '"') {
+            // Unquote in place: the text shifts left over the quotes
+            char* out = p++;
+            while (*p && !(*p == '"' && p[1] != '"')) {
+                if (*p == '"') p++;
+                *out++ = *p++;
+            }
+            if (*p == '"') p++;
+            while (*p && *p != ',') p++;
+            bool more = *p == ',';
+            *out = '\0';
+            if (count <= maxFields) fields[count] = field;
+            count++;
+            if (!more) break;
+            p++;
+            continue;
+        }
+        
+        while (*p && *p != ',') p++;
+        bool more = *p == ',';
+        *p = '\0';
+        if (count <= maxFields) fields[count] = field;
+        count++;
+        if (!more) break;
+        p++;
+    }
+    return count;
+}
+
+/**
+ * Whole-field decimal integer
+ */
+static bool parseIntField(const char* text, int* value) {
+    const char* p = text;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+    if (*p < '0' || *p > '9') return false;
+    
+    long result = 0;
+    while (*p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+        if (result > INT_MAX) return false;
+    }
+    if (*p != '\0') return false;
+    *value = (int)(negative ? -result : result);
+    return true;
+}
+
+/**
+ * Whole-field decimal number. With at most 15 significant digits and 22
+ * decimals the result is one exact division, identical to strtod; longer
+ * numbers and exponents are handed to strtod.
+ */
+static bool parseDoubleField(const char* text, double* value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char* p = text;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+    
+    long long mantissa = 0;
+    int significant = 0, decimals = 0, numDigits = 0;
+    bool inFraction = false;
+    for (; (*p >= '0' && *p <= '9') || (*p == '.' && !inFraction); p++) {
+        if (*p == '.') {
+            inFraction = true;
+            continue;
+        }
+        numDigits++;
+        if (significant <= 15) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa > 0) significant++;
+        }
+        if (inFraction) decimals++;
+    }
+    
+    if (numDigits == 0) return false;
+    if (*p != '\0' || significant > 15 || decimals > 22) {
+        char* end;
+        *value = strtod(text, &end);
+        return end != text && *end == '\0';
+    }
+    double result = (double)mantissa / powers[decimals];
+    *value = negative ? -result : result;
+    return true;
+}
+
+/**
+ * Index of a mode in the worker's list, adding it in pass 1.
+ * Returns -1 if the range uses more than MAX_MODES modes.
+ */
+static int workerMode(RouteWorker* worker, const char* mode) {
+    for (int i = 0; i < worker->numModes; i++) {
+        if (strcmp(worker->modes[i], mode) == 0) return i;
+    }
+    if (worker->numModes == MAX_MODES) return -1;
+    
+    strcpy(worker->modes[worker->numModes], mode);
+    return worker->numModes++;
+}
+
+/**
+ * Remember a line's endpoints for pass 2
+ */
+static bool recordLine(RouteWorker* worker, int from, int to) {
+    if (worker->numLines == worker->lineCapacity) {
+        long capacity = worker->lineCapacity > 0 ? worker->lineCapacity * 2 : 4096;
+        int* grown = (int*)realloc(worker->endpoints, capacity * 2 * sizeof(int));
+        if (!grown) {
+            fprintf(stderr, "Error: Memory allocation failed for route endpoints\n");
+            return false;
+        }
+        worker->endpoints = grown;
+        worker->lineCapacity = capacity;
+    }
+    worker->endpoints[2 * worker->numLines] = from;
+    worker->endpoints[2 * worker->numLines + 1] = to;
+    worker->numLines++;
+    return true;
+}
+
+/**
+ * Parse and apply every route line of the worker's byte range. Pass 2
+ * reads the same lines and takes validity and city indices from pass 1.
+ */
+static void* routeWorker(void* arg) {
+    RouteWorker* worker = (RouteWorker*)arg;
+    RouteLoad* load = worker->load;
+    CSRGraph* csr = load->csr;
+    
+    ChunkReader reader;
+    if (!openChunkReader(&reader, load->path, worker->start)) {
+        worker->failed = true;
+        return NULL;
+    }
+    
+    char* line;
+    long lineStart;
+    long lineNumber = 0;
+    while (!worker->failed && (line = nextLine(&reader, &lineStart)) && lineStart < worker->end) {
+        if (line[0] == '\0') continue;
+        
+        char* fields[7];
+        int from, to, distance, cost, mode;
+        double time;
+        if (!load->fillPass) {
+            if (splitFields(line, fields, 6) != 6 ||
+                (from = findCityIndex(load->graph, fields[0])) == -1 ||
+                (to = findCityIndex(load->graph, fields[1])) == -1 ||
+                !parseIntField(fields[2], &distance) || !parseDoubleField(fields[3], &time) ||
+                !parseIntField(fields[4], &cost) || !validRouteWeights(distance, time, cost) ||
+                strlen(fields[5]) >= MAX_MODE_LENGTH) {
+                if (lineStart > 0) worker->skipped++;   // a bad first line is the header
+                worker->failed = !recordLine(worker, -1, -1);
+                continue;
+            }
+            if (workerMode(worker, fields[5]) == -1) {
+                fprintf(stderr, "Error: More than %d transport modes\n", MAX_MODES);
+                worker->failed = true;
+                break;
+            }
+            worker->loaded++;
+            worker->failed = !recordLine(worker, from, to);
+            worker->degree[from]++;
+            if (!load->isDirected) worker->degree[to]++;
+            continue;
+        }
+        
+        // Pass 2: the line is known to be valid unless pass 1 marked it
+        from = worker->endpoints[2 * lineNumber];
+        to = worker->endpoints[2 * lineNumber + 1];
+        lineNumber++;
+        if (from == -1) continue;
+        
+        splitFields(line, fields, 6);
+        parseIntField(fields[2], &distance);
+        parseDoubleField(fields[3], &time);
+        parseIntField(fields[4], &cost);
+        mode = worker->modeIds[workerMode(worker, fields[5])];
+        for (int side = 0; side < (load->isDirected ? 1 : 2); side++) {
+            int source = side == 0 ? from : to;
+            int e = worker->degree[source]++;
+            csr->target[e] = side == 0 ? to : from;
+            csr->distance[e] = distance;
+            csr->time[e] = time;
+            csr->timeWeight[e] = (int)(time * 100); // Same scale as getWeight
+            csr->cost[e] = cost;
+            csr->modeId[e] = (unsigned char)mode;
+        }
+    }
+    
+    closeChunkReader(&reader);
+    return NULL;
+}
+
+/**
+ * Run one pass over all byte ranges, one thread per range
+ */
+static bool runRoutePass(RouteWorker* workers, int numWorkers) {
+    pthread_t* threads = (pthread_t*)malloc(numWorkers * sizeof(pthread_t));
+    bool* started = (bool*)calloc(numWorkers, sizeof(bool));
+    if (!threads || !started) {
+        free(threads);
+        free(started);
+        return false;
+    }
+    
+    for (int t = 1; t < numWorkers; t++) {
+        started[t] = pthread_create(&threads[t], NULL, routeWorker, &workers[t]) == 0;
+    }
+    routeWorker(&workers[0]);
+    
+    bool ok = !workers[0].failed;
+    for (int t = 1; t < numWorkers; t++) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        } else {
+            routeWorker(&workers[t]);
+        }
+        ok = ok && !workers[t].failed;
+    }
+    free(threads);
+    free(started);
+    return ok;
+}
+
+/**
+ * Stream cities.csv into the graph with addCity
+ */
+static bool loadCities(Graph* graph, const char* path, CSVLoadStats* stats) {
+    ChunkReader reader;
+    if (!openChunkReader(&reader, path, 0)) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return false;
+    }
+    
+    char* line;
+    long lineStart;
+    while ((line = nextLine(&reader, &lineStart))) {
+        if (line[0] == '\0') continue;
+        
+        char* fields[5];
+        double lat, lon;
+        if (splitFields(line, fields, 4) != 4 || fields[0][0] == '\0' ||
+            strlen(fields[0]) >= sizeof(graph->cities[0].id) ||
+            strlen(fields[1]) >= sizeof(graph->cities[0].name) ||
+            !parseDoubleField(fields[2], &lat) || !parseDoubleField(fields[3], &lon) ||
+            addCity(graph, fields[0], fields[1], lat, lon) == -1) {
+            if (lineStart > 0) stats->citiesSkipped++;   // a bad first line is the header
+            continue;
+        }
+        stats->citiesLoaded++;
+    }
+    
+    closeChunkReader(&reader);
+    return true;
+}
+
+/**
+ * Two-pass parallel route load straight into the graph's CSR snapshot
+ */
+static bool loadRoutes(Graph* graph, const char* path, bool isDirected, int numThreads,
+                       CSVLoadStats* stats) {
+    FILE* probe = fopen(path, "rb");
+    if (!probe) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return false;
+    }
+    fseek(probe, 0, SEEK_END);
+    long fileSize = ftell(probe);
+    fclose(probe);
+    
+    if (numThreads <= 0) numThreads = getDefaultThreadCount();
+    if (fileSize < CSV_PARALLEL_MIN_BYTES) numThreads = 1;
+    
+    int n = graph->numCities;
+    RouteLoad load = {graph, NULL, path, isDirected, false};
+    RouteWorker* workers = (RouteWorker*)calloc(numThreads, sizeof(RouteWorker));
+    bool ok = workers != NULL;
+    for (int t = 0; ok && t < numThreads; t++) {
+        workers[t].load = &load;
+        workers[t].start = fileSize / numThreads * t;
+        workers[t].end = t == numThreads - 1 ? fileSize + 1 : fileSize / numThreads * (t + 1);
+        workers[t].degree = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+        ok = workers[t].degree != NULL;
+    }
+    
+    // Pass 1: edges per city from each range
+    ok = ok && runRoutePass(workers, numThreads);
+    
+    long numEdges = 0;
+    for (int t = 0; ok && t < numThreads; t++) {
+        numEdges += isDirected ? workers[t].loaded : 2 * workers[t].loaded;
+    }
+    if (ok && numEdges > INT_MAX) {
+        fprintf(stderr, "Error: Too many routes in %s\n", path);
+        ok = false;
+    }
+    
+    // Intern modes range by range, so ids follow file order as in a
+    // single-threaded load; the snapshot copies the graph's mode table
+    for (int t = 0; ok && t < numThreads; t++) {
+        for (int i = 0; ok && i < workers[t].numModes; i++) {
+            workers[t].modeIds[i] = internMode(graph, workers[t].modes[i]);
+            if (workers[t].modeIds[i] == -1) {
+                fprintf(stderr, "Error: More than %d transport modes\n", MAX_MODES);
+                ok = false;
+            }
+        }
+    }
+    if (ok) {
+        load.csr = createCSRGraph(graph, (int)numEdges);
+        ok = load.csr != NULL;
+    }
+    
+    if (ok) {
+        // Each range writes its edges after those of earlier ranges, so the
+        // result is file order whatever the thread count
+        int next = 0;
+        for (int i = 0; i < n; i++) {
+            load.csr->offsets[i] = next;
+            for (int t = 0; t < numThreads; t++) {
+                int count = workers[t].degree[i];
+                workers[t].degree[i] = next;
+                next += count;
+            }
+        }
+        load.csr->offsets[n] = next;
+        
+        // Pass 2: fill
+        load.fillPass = true;
+        ok = runRoutePass(workers, numThreads);
+    }
+    
+    ok = ok && buildReverseIndex(load.csr);
+    
+    for (int t = 0; workers && t < numThreads; t++) {
+        stats->routesLoaded += workers[t].loaded;
+        stats->routesSkipped += workers[t].skipped;
+        free(workers[t].degree);
+        free(workers[t].endpoints);
+    }
+    free(workers);
+    
+    if (!ok) {
+        destroyCSRGraph(load.csr);
+        return false;
+    }
+    graph->frozen = load.csr;
+    graph->numRoutes = (int)stats->routesLoaded;
+    graph->edgesOnlyInCSR = true;
+    graph->version++;
+    return true;
+}
+
+/**
+ * Build a graph from cities.csv and routes.csv (numThreads <= 0: one per
+ * processor). stats may be NULL. Returns NULL if a file cannot be read.
+ */
+Graph* loadGraphCSV(const char* citiesPath, const char* routesPath, bool isDirected,
+                    int numThreads, CSVLoadStats* stats) {
+    CSVLoadStats localStats;
+    if (!stats) stats = &localStats;
+    memset(stats, 0, sizeof(*stats));
+    
+    Graph* graph = createGraph(isDirected);
+    if (!graph) return NULL;
+    
+    if (!loadCities(graph, citiesPath, stats) ||
+        !loadRoutes(graph, routesPath, isDirected, numThreads, stats)) {
+        destroyGraph(graph);
+        return NULL;
+    }
+    return graph;
+}
@@ -0,0 +1,25 @@
+/**
+ * CSV Graph Loader Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "graph.h"
+
+#define CSV_CHUNK_SIZE (1 << 20)
+#define CSV_PARALLEL_MIN_BYTES (8L << 20)   // smaller route files are parsed on one thread
+
+// Rows accepted and rejected by loadGraphCSV
+typedef struct {
+    long citiesLoaded;
+    long citiesSkipped;       // malformed, too long or duplicate id
+    long routesLoaded;
+    long routesSkipped;       // malformed, bad number, unknown city or mode too long
+} CSVLoadStats;
+
+Graph* loadGraphCSV(const char* citiesPath, const char* routesPath, bool isDirected,
+                    int numThreads, CSVLoadStats* stats);
+
+#endif // LOADER_H
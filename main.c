@@ -7,15 +7,44 @@
  */
 
 #include "graph.h"
+#include "alt.h"
+#include "batch.h"
+#include "writer.h"
+#include "graphfile.h"
+#include "loader.h"
+#include "pareto.h"
+#include "ksp.h"
+#include "timetable.h"
+
+#define BATCH_CHUNK_SIZE 4096
+#define MAX_QUERY_LINE 256
+
+typedef enum {
+    FORMAT_CSV,
+    FORMAT_JSONL
+} OutputFormat;
+
+// One parsed input line of batch mode
+typedef struct {
+    char startId[32];
+    char endId[32];
+    const char* error;        // NULL when the query is valid
+} BatchLine;
 
 // Function prototypes
 void initializeSampleData(Graph* graph);
+void loadSampleData(Graph* graph);
+int runBatchMode(int argc, char* argv[]);
 void displayMenu();
 void findRoute(Graph* graph);
 void displayAllCities(Graph* graph);
 void testAllAlgorithms(Graph* graph);
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatchMode(argc, argv);
+    }
+    
     printf("========================================\n");
     printf("  Travel Route Planner - India (C)    \n");
     printf("  Graph Algorithms Mini Project        \n");
@@ -98,6 +127,71 @@ void displayAllCities(Graph* graph) {
     printf("\n");
 }
 
+/**
+ * Earliest arrival on a timetable of regular services over the sample
+ * routes, then the later departures worth taking in the next 6 hours
+ */
+static void planJourney(Graph* graph, const char* startId, const char* endId) {
+    char clock[16];
+    printf("Leave after (HH:MM): ");
+    scanf("%15s", clock);
+    
+    int departAfter = parseClockTime(clock);
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
+    if (departAfter == -1 || start == -1 || end == -1) {
+        printf("Invalid city or time.\n\n");
+        return;
+    }
+    
+    Timetable* timetable = buildTimetableFromRoutes(graph, 0, 2 * MINUTES_PER_DAY);
+    Journey* journey = timetable ? earliestArrival(timetable, start, end, departAfter) : NULL;
+    if (journey) {
+        printJourney(timetable, journey);
+        
+        Profile* profile = profileQuery(timetable, start, end, journey->departureTime + 1,
+                                        departAfter + 6 * 60);
+        for (int i = 0; profile && i < profile->numEntries; i++) {
+            char departure[16], arrival[16];
+            formatClockTime(profile->entries[i].departureTime, departure, sizeof(departure));
+            formatClockTime(profile->entries[i].arrivalTime, arrival, sizeof(arrival));
+            if (i == 0) printf("\nLater departures:\n");
+            printf("  leave %s, arrive %s\n", departure, arrival);
+        }
+        destroyProfile(profile);
+    } else {
+        printf("\nNo connection found between %s and %s\n", startId, endId);
+    }
+    
+    destroyJourney(journey);
+    destroyTimetable(timetable);
+    printf("\n");
+}
+
+/**
+ * Dijkstra (1), A* (2), BFS (3), DFS (4) or bidirectional Dijkstra (5) over the
+ * allowed transport modes only
+ */
+static PathResult* findModeRoute(Graph* graph, int algoChoice, const char* startId,
+                                 const char* endId, const char* weightType, ModeMask modes) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (start == -1 || end == -1 || !ctx) return NULL;
+    
+    WeightMetric metric = parseWeightType(weightType);
+    if (algoChoice == 1) return dijkstraQuery(graph, ctx, start, end, metric, modes);
+    if (algoChoice == 3) return bfsQuery(graph, ctx, start, end, modes);
+    if (algoChoice == 4) return dfsQuery(graph, ctx, start, end, modes);
+    if (algoChoice == 5) {
+        QueryContext* backward = getGraphQueryContext(graph, true);
+        if (!backward) return NULL;
+        return bidirectionalDijkstraQuery(graph, ctx, backward, start, end, metric, modes);
+    }
+    prepareLandmarks(graph, metric, ALT_DEFAULT_LANDMARKS);
+    return aStarQuery(graph, ctx, start, end, metric, modes);
+}
+
 /**
  * Find route between two cities
  */
@@ -119,12 +213,16 @@ void findRoute(Graph* graph) {
     printf("2. A* Algorithm (Fast Optimal)\n");
     printf("3. BFS (Minimum Stops)\n");
     printf("4. DFS (Any Path)\n");
+    printf("5. Bidirectional Dijkstra (Optimal, Long Routes)\n");
+    printf("6. All Trade-offs (Distance vs Time vs Cost)\n");
+    printf("7. Timetable (Earliest Arrival)\n");
+    printf("8. Top 5 Alternatives\n");
     printf("Choice: ");
     scanf("%d", &algoChoice);
     
     char weightType[20] = "distance";
     
-    if (algoChoice == 1 || algoChoice == 2) {
+    if (algoChoice == 1 || algoChoice == 2 || algoChoice == 5 || algoChoice == 8) {
         printf("\nOptimize For:\n");
         printf("1. Distance (km)\n");
         printf("2. Time (hours)\n");
@@ -144,21 +242,64 @@ void findRoute(Graph* graph) {
         }
     }
     
+    ModeMask modes = MODE_MASK_ALL;
+    if (algoChoice >= 1 && algoChoice <= 5) {
+        char modeSpec[64];
+        printf("\nAllowed modes (all, e.g. Train+Bus, or -Flight to avoid): ");
+        scanf("%63s", modeSpec);
+        if (!parseModeMask(graph, modeSpec, &modes)) {
+            printf("Unknown transport mode '%s'.\n\n", modeSpec);
+            return;
+        }
+    }
+    
+    if (algoChoice == 6) {
+        ParetoSet* set = paretoRoutes(graph, startId, endId);
+        if (set && set->numResults > 0) {
+            printf("\n%d routes where no other is shorter, faster and cheaper at once:\n",
+                   set->numResults);
+            for (int i = 0; i < set->numResults; i++) {
+                printPath(graph, set->results[i]);
+            }
+        } else {
+            printf("\nNo path found between %s and %s\n", startId, endId);
+        }
+        destroyParetoSet(set);
+        printf("\n");
+        return;
+    }
+    
+    if (algoChoice == 7) {
+        planJourney(graph, startId, endId);
+        return;
+    }
+    
+    if (algoChoice == 8) {
+        RankedPaths* paths = kShortestPaths(graph, startId, endId, weightType, 5);
+        if (paths && paths->numResults > 0) {
+            printf("\n%d best routes by %s:\n", paths->numResults, weightType);
+            for (int i = 0; i < paths->numResults; i++) {
+                printf("\n#%d", i + 1);
+                printPath(graph, paths->results[i]);
+            }
+        } else {
+            printf("\nNo path found between %s and %s\n", startId, endId);
+        }
+        destroyRankedPaths(paths);
+        printf("\n");
+        return;
+    }
+    
     // Find path using selected algorithm
     PathResult* result = NULL;
     
     switch (algoChoice) {
         case 1:
-            result = dijkstra(graph, startId, endId, weightType);
-            break;
         case 2:
-            result = aStar(graph, startId, endId, weightType);
-            break;
         case 3:
-            result = bfs(graph, startId, endId);
-            break;
         case 4:
-            result = dfs(graph, startId, endId);
+        case 5:
+            result = findModeRoute(graph, algoChoice, startId, endId, weightType, modes);
             break;
         default:
             printf("Invalid algorithm choice.\n");
@@ -204,6 +345,15 @@ void testAllAlgorithms(Graph* graph) {
     
     printf("\n");
     
+    // Test Bidirectional Dijkstra
+    PathResult* result5 = bidirectionalDijkstra(graph, startId, endId, "distance");
+    if (result5) {
+        printPath(graph, result5);
+        destroyPathResult(result5);
+    }
+    
+    printf("\n");
+    
     // Test A*
     PathResult* result2 = aStar(graph, startId, endId, "distance");
     if (result2) {
@@ -231,3 +381,282 @@ void testAllAlgorithms(Graph* graph) {
     
     printf("\n========================================\n");
 }
+
+static const char* metricNames[METRIC_COUNT] = {"distance", "time", "cost"};
+
+/**
+ * Drop what fgets left of an over-long line. Returns true if anything but
+ * the line ending was dropped.
+ */
+static bool skipRestOfLine(FILE* input) {
+    bool dropped = false;
+    int c;
+    while ((c = getc(input)) != '\n' && c != EOF) {
+        if (c != '\r') dropped = true;
+    }
+    return dropped;
+}
+
+/**
+ * Split one input line "start end [algorithm [metric [modes]]]" (comma, tab
+ * or space separated; modes joined by '+', e.g. Train+Bus or -Flight) into a
+ * query. A truncated line is reported malformed. Returns false for blank and
+ * comment lines.
+ */
+static bool parseQueryLine(Graph* graph, char* text, bool truncated, BatchQuery* query,
+                           BatchLine* line) {
+    char* fields[5] = {NULL, NULL, "dijkstra", "distance", "all"};
+    int numFields = 0;
+    for (char* token = strtok(text, ", \t\r\n"); token && numFields < 6;
+         token = strtok(NULL, ", \t\r\n")) {
+        if (numFields == 0 && token[0] == '#') return false;
+        if (numFields < 5) fields[numFields] = token;
+        numFields++;
+    }
+    if (numFields == 0) return false;
+    if (numFields >= 2 && strcmp(fields[0], "start") == 0 && strcmp(fields[1], "end") == 0) {
+        return false;         // CSV header
+    }
+    
+    snprintf(line->startId, sizeof(line->startId), "%s", fields[0]);
+    snprintf(line->endId, sizeof(line->endId), "%s", fields[1] ? fields[1] : "");
+    line->error = NULL;
+    query->start = -1;
+    query->end = -1;
+    query->algorithm = ALGORITHM_DIJKSTRA;
+    query->metric = METRIC_DISTANCE;
+    query->modes = MODE_MASK_ALL;
+    
+    int algorithm = parseAlgorithm(fields[2]);
+    int metric = -1;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        if (strcmp(fields[3], metricNames[m]) == 0) metric = m;
+    }
+    
+    if (truncated || numFields < 2 || numFields > 5) {
+        line->error = "malformed line";
+    } else if (algorithm == -1) {
+        line->error = "unknown algorithm";
+    } else if (metric == -1) {
+        line->error = "unknown metric";
+    } else if (!parseModeMask(graph, fields[4], &query->modes)) {
+        line->error = "unknown mode";
+    } else {
+        query->start = findCityIndex(graph, fields[0]);
+        query->end = findCityIndex(graph, fields[1]);
+        query->algorithm = (QueryAlgorithm)algorithm;
+        query->metric = (WeightMetric)metric;
+        if (query->start == -1 || query->end == -1) line->error = "unknown city";
+    }
+    return true;
+}
+
+/**
+ * Write one result row as CSV or a JSON object line
+ */
+static void writeBatchResult(BufferedWriter* out, OutputFormat format, Graph* graph,
+                             const BatchLine* line, const BatchQuery* query,
+                             const PathResult* result) {
+    const char* status = line->error ? line->error : result ? "ok" : "no path";
+    const char* algorithm = line->error ? "" : getAlgorithmName(query->algorithm);
+    const char* metric = line->error ? "" : metricNames[query->metric];
+    
+    if (format == FORMAT_CSV) {
+        writeString(out, line->startId);
+        writeChar(out, ',');
+        writeString(out, line->endId);
+        writeChar(out, ',');
+        writeString(out, algorithm);
+        writeChar(out, ',');
+        writeString(out, metric);
+        writeChar(out, ',');
+        writeString(out, status);
+        if (result) {
+            writeChar(out, ',');
+            writeInt(out, result->totalDistance);
+            writeChar(out, ',');
+            writeFixed2(out, result->totalTime);
+            writeChar(out, ',');
+            writeInt(out, result->totalCost);
+            writeChar(out, ',');
+            writeInt(out, result->pathLength - 1);
+            writeChar(out, ',');
+            for (int i = 0; i < result->pathLength; i++) {
+                if (i > 0) writeChar(out, ';');
+                writeString(out, graph->cities[result->path[i]].id);
+            }
+        } else {
+            writeString(out, ",,,,,");
+        }
+        writeChar(out, '\n');
+        return;
+    }
+    
+    writeString(out, "{\"start\":");
+    writeJsonString(out, line->startId);
+    writeString(out, ",\"end\":");
+    writeJsonString(out, line->endId);
+    writeString(out, ",\"algorithm\":");
+    writeJsonString(out, algorithm);
+    writeString(out, ",\"metric\":");
+    writeJsonString(out, metric);
+    writeString(out, ",\"status\":");
+    writeJsonString(out, status);
+    if (result) {
+        writeString(out, ",\"distance\":");
+        writeInt(out, result->totalDistance);
+        writeString(out, ",\"time\":");
+        writeFixed2(out, result->totalTime);
+        writeString(out, ",\"cost\":");
+        writeInt(out, result->totalCost);
+        writeString(out, ",\"legs\":");
+        writeInt(out, result->pathLength - 1);
+        writeString(out, ",\"path\":[");
+        for (int i = 0; i < result->pathLength; i++) {
+            if (i > 0) writeChar(out, ',');
+            writeJsonString(out, graph->cities[result->path[i]].id);
+        }
+        writeChar(out, ']');
+    }
+    writeString(out, "}\n");
+}
+
+/**
+ * Run every query of a chunk on the pool and write the results in order
+ */
+static void flushBatchChunk(QueryPool* pool, BufferedWriter* out, OutputFormat format,
+                            BatchQuery* queries, BatchLine* lines, PathResult** results,
+                            int count) {
+    runBatch(pool, queries, count, results);
+    for (int i = 0; i < count; i++) {
+        writeBatchResult(out, format, pool->graph, &lines[i], &queries[i], results[i]);
+        destroyPathResult(results[i]);
+    }
+}
+
+static void printBatchUsage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s --batch <file|-> [--format csv|jsonl] [--threads N] [--output file]\n"
+            "          [--graph graph.bin | --cities cities.csv --routes routes.csv] [--tree-cache N]\n"
+            "Each input line: start end [dijkstra|astar|bidirectional|bfs|dfs [distance|time|cost [modes]]]\n"
+            "modes: all (default), Train+Bus (only those) or -Flight (all but those)\n"
+            "--tree-cache N keeps the shortest-path trees of the N most recent Dijkstra origins\n",
+            program);
+}
+
+/**
+ * Non-interactive mode: answer queries from a file or stdin in chunks on a
+ * worker pool and stream the results through a buffered writer
+ */
+int runBatchMode(int argc, char* argv[]) {
+    const char* inputPath = NULL;
+    const char* outputPath = NULL;
+    const char* graphPath = NULL;
+    const char* citiesPath = NULL;
+    const char* routesPath = NULL;
+    OutputFormat format = FORMAT_CSV;
+    int numThreads = 0;
+    int treeCacheSize = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            inputPath = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (strcmp(argv[i], "--graph") == 0 && i + 1 < argc) {
+            graphPath = argv[++i];
+        } else if (strcmp(argv[i], "--cities") == 0 && i + 1 < argc) {
+            citiesPath = argv[++i];
+        } else if (strcmp(argv[i], "--routes") == 0 && i + 1 < argc) {
+            routesPath = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tree-cache") == 0 && i + 1 < argc) {
+            treeCacheSize = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "csv") == 0) {
+                format = FORMAT_CSV;
+            } else if (strcmp(argv[i], "jsonl") == 0 || strcmp(argv[i], "json") == 0) {
+                format = FORMAT_JSONL;
+            } else {
+                printBatchUsage(argv[0]);
+                return 2;
+            }
+        } else {
+            printBatchUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (!inputPath || !citiesPath != !routesPath || (graphPath && citiesPath)) {
+        printBatchUsage(argv[0]);
+        return 2;
+    }
+    
+    FILE* input = strcmp(inputPath, "-") == 0 ? stdin : fopen(inputPath, "r");
+    if (!input) {
+        fprintf(stderr, "Error: Cannot open %s\n", inputPath);
+        return 1;
+    }
+    FILE* output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (!output) {
+        fprintf(stderr, "Error: Cannot open %s\n", outputPath);
+        if (input != stdin) fclose(input);
+        return 1;
+    }
+    
+    // A binary graph file is mapped as is, CSV files are bulk loaded;
+    // otherwise use the sample network
+    Graph* graph;
+    if (graphPath) {
+        graph = loadGraphBinary(graphPath);
+    } else if (citiesPath) {
+        graph = loadGraphCSV(citiesPath, routesPath, false, numThreads, NULL);
+    } else {
+        graph = createGraph(false);
+        if (graph) loadSampleData(graph);
+    }
+    QueryPool* pool = graph ? createQueryPool(graph, numThreads) : NULL;
+    SPTCache* treeCache = pool && treeCacheSize > 0 ? createSPTCache(graph, treeCacheSize) : NULL;
+    if (pool) pool->treeCache = treeCache;
+    BatchQuery* queries = (BatchQuery*)malloc(BATCH_CHUNK_SIZE * sizeof(BatchQuery));
+    BatchLine* lines = (BatchLine*)malloc(BATCH_CHUNK_SIZE * sizeof(BatchLine));
+    PathResult** results = (PathResult**)malloc(BATCH_CHUNK_SIZE * sizeof(PathResult*));
+    BufferedWriter out;
+    bool ok = pool && (treeCache || treeCacheSize <= 0) && queries && lines && results &&
+              initWriter(&out, output, WRITER_BUFFER_SIZE);
+    
+    if (ok) {
+        if (format == FORMAT_CSV) {
+            writeString(&out, "start,end,algorithm,metric,status,distance,time,cost,legs,path\n");
+        }
+        
+        char text[MAX_QUERY_LINE];
+        int count = 0;
+        while (fgets(text, sizeof(text), input)) {
+            // A line longer than the buffer is one malformed row, not several queries
+            bool truncated = !strchr(text, '\n') && skipRestOfLine(input);
+            if (!parseQueryLine(graph, text, truncated, &queries[count], &lines[count])) continue;
+            if (++count == BATCH_CHUNK_SIZE) {
+                flushBatchChunk(pool, &out, format, queries, lines, results, count);
+                count = 0;
+            }
+        }
+        flushBatchChunk(pool, &out, format, queries, lines, results, count);
+        
+        ok = closeWriter(&out);
+        if (!ok) fprintf(stderr, "Error: Failed writing results\n");
+    } else {
+        fprintf(stderr, "Error: Failed to start batch mode\n");
+    }
+    
+    free(queries);
+    free(lines);
+    free(results);
+    destroyQueryPool(pool);
+    destroySPTCache(treeCache);
+    destroyGraph(graph);
+    if (input != stdin) fclose(input);
+    if (output != stdout) fclose(output);
+    return ok ? 0 : 1;
+}
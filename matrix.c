@@ -0,0 +1,214 @@
+/**
+ * Distance Matrix Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * One Dijkstra per source row, stopped as soon as every target is settled.
+ * Rows are handed out to worker threads through a shared counter; each
+ * worker owns a QueryContext and writes only its own rows.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "matrix.h"
+
+typedef struct {
+    const CSRGraph* csr;
+    const int* weights;
+    const int* sources;
+    const int* targets;
+    const unsigned char* isTarget;   // per city, 1 if any column wants it
+    int numSources;
+    int numTargets;
+    int numDistinctTargets;
+    int* values;
+    atomic_int nextRow;
+    atomic_bool failed;
+} MatrixJob;
+
+/**
+ * Number of online processors, at least 1
+ */
+int getDefaultThreadCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+/**
+ * Dijkstra from source until every distinct target city is settled
+ */
+static void settleTargets(const MatrixJob* job, QueryContext* ctx, int source) {
+    const CSRGraph* csr = job->csr;
+    int* dist = ctx->dist;
+    MinHeap* pq = &ctx->heap;
+    int remaining = job->numDistinctTargets;
+    
+    touchCity(ctx, source);
+    dist[source] = 0;
+    heapPushOrDecrease(pq, source, 0);
+    
+    while (!heapIsEmpty(pq)) {
+        int current = heapPopMin(pq);
+        markVisited(ctx, current);
+        if (job->isTarget[current] && --remaining == 0) break;
+        
+        for (int e = csr->offsets[current]; e < csr->offsets[current + 1]; e++) {
+            int next = csr->target[e];
+            int newDist = dist[current] + job->weights[e];
+            
+            touchCity(ctx, next);
+            if (newDist < dist[next]) {
+                dist[next] = newDist;
+                heapPushOrDecrease(pq, next, newDist);
+            }
+        }
+    }
+}
+
+/**
+ * Worker: claim rows until none are left
+ */
+static void* matrixWorker(void* arg) {
+    MatrixJob* job = (MatrixJob*)arg;
+    QueryContext* ctx = createQueryContext(job->csr->numCities);
+    if (!ctx) {
+        atomic_store(&job->failed, true);
+        return NULL;
+    }
+    
+    int row;
+    while ((row = atomic_fetch_add(&job->nextRow, 1)) < job->numSources) {
+        if (!beginQuery(ctx, job->csr->numCities)) {
+            atomic_store(&job->failed, true);
+            break;
+        }
+        if (job->numDistinctTargets > 0) settleTargets(job, ctx, job->sources[row]);
+        
+        int* out = &job->values[(size_t)row * job->numTargets];
+        for (int j = 0; j < job->numTargets; j++) {
+            out[j] = queryDistance(ctx, job->targets[j]);
+        }
+    }
+    
+    destroyQueryContext(ctx);
+    return NULL;
+}
+
+/**
+ * Many-to-many shortest-path weights by city index.
+ * numThreads <= 0 uses one thread per processor.
+ */
+DistanceMatrix* distanceMatrixQuery(Graph* graph, const int* sources, int numSources,
+                                    const int* targets, int numTargets, WeightMetric metric,
+                                    int numThreads) {
+    // Freeze before any thread starts; workers only read the snapshot
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || numSources < 0 || numTargets < 0) return NULL;
+    int n = csr->numCities;
+    for (int i = 0; i < numSources; i++) {
+        if (sources[i] < 0 || sources[i] >= n) return NULL;
+    }
+    for (int j = 0; j < numTargets; j++) {
+        if (targets[j] < 0 || targets[j] >= n) return NULL;
+    }
+    
+    DistanceMatrix* matrix = (DistanceMatrix*)malloc(sizeof(DistanceMatrix));
+    unsigned char* isTarget = (unsigned char*)calloc(n > 0 ? n : 1, sizeof(unsigned char));
+    size_t cells = (size_t)numSources * numTargets;
+    int* values = (int*)malloc((cells > 0 ? cells : 1) * sizeof(int));
+    if (!matrix || !isTarget || !values) {
+        fprintf(stderr, "Error: Memory allocation failed for distance matrix\n");
+        free(matrix);
+        free(isTarget);
+        free(values);
+        return NULL;
+    }
+    matrix->numSources = numSources;
+    matrix->numTargets = numTargets;
+    matrix->metric = metric;
+    matrix->values = values;
+    
+    MatrixJob job;
+    job.csr = csr;
+    job.weights = csrWeights(csr, metric);
+    job.sources = sources;
+    job.targets = targets;
+    job.isTarget = isTarget;
+    job.numSources = numSources;
+    job.numTargets = numTargets;
+    job.numDistinctTargets = 0;
+    job.values = values;
+    atomic_init(&job.nextRow, 0);
+    atomic_init(&job.failed, false);
+    for (int j = 0; j < numTargets; j++) {
+        if (!isTarget[targets[j]]) {
+            isTarget[targets[j]] = 1;
+            job.numDistinctTargets++;
+        }
+    }
+    
+    if (numThreads <= 0) numThreads = getDefaultThreadCount();
+    if (numThreads > numSources) numThreads = numSources > 0 ? numSources : 1;
+    
+    // The calling thread is worker 0
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    int started = 0;
+    if (threads) {
+        for (int t = 1; t < numThreads; t++) {
+            if (pthread_create(&threads[started], NULL, matrixWorker, &job) != 0) break;
+            started++;
+        }
+    }
+    matrixWorker(&job);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    free(isTarget);
+    
+    if (atomic_load(&job.failed)) {
+        fprintf(stderr, "Error: Memory allocation failed for distance matrix\n");
+        destroyDistanceMatrix(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+/**
+ * Many-to-many shortest-path weights by city ID
+ */
+DistanceMatrix* distanceMatrix(Graph* graph, const char** sourceIds, int numSources,
+                               const char** targetIds, int numTargets, const char* weightType) {
+    int* sources = (int*)malloc((numSources > 0 ? numSources : 1) * sizeof(int));
+    int* targets = (int*)malloc((numTargets > 0 ? numTargets : 1) * sizeof(int));
+    DistanceMatrix* matrix = NULL;
+    
+    if (sources && targets) {
+        bool found = true;
+        for (int i = 0; i < numSources && found; i++) {
+            sources[i] = findCityIndex(graph, sourceIds[i]);
+            found = sources[i] != -1;
+        }
+        for (int j = 0; j < numTargets && found; j++) {
+            targets[j] = findCityIndex(graph, targetIds[j]);
+            found = targets[j] != -1;
+        }
+        if (found) {
+            matrix = distanceMatrixQuery(graph, sources, numSources, targets, numTargets,
+                                         parseWeightType(weightType), 0);
+        }
+    }
+    
+    free(sources);
+    free(targets);
+    return matrix;
+}
+
+/**
+ * Destroy distance matrix and free memory
+ */
+void destroyDistanceMatrix(DistanceMatrix* matrix) {
+    if (!matrix) return;
+    free(matrix->values);
+    free(matrix);
+}
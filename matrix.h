@@ -0,0 +1,35 @@
+/**
+ * Distance Matrix Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "graph.h"
+#include "query.h"
+
+// Shortest-path weights from every source to every target for one metric.
+// values is row-major: values[i * numTargets + j] is sources[i] -> targets[j]
+// in search units (km, hundredths of an hour, rupees), INFINITY_DIST when
+// the target cannot be reached.
+typedef struct {
+    int numSources;
+    int numTargets;
+    WeightMetric metric;
+    int* values;
+} DistanceMatrix;
+
+DistanceMatrix* distanceMatrix(Graph* graph, const char** sourceIds, int numSources,
+                               const char** targetIds, int numTargets, const char* weightType);
+DistanceMatrix* distanceMatrixQuery(Graph* graph, const int* sources, int numSources,
+                                    const int* targets, int numTargets, WeightMetric metric,
+                                    int numThreads);
+void destroyDistanceMatrix(DistanceMatrix* matrix);
+int getDefaultThreadCount(void);
+
+static inline int matrixValue(const DistanceMatrix* matrix, int source, int target) {
+    return matrix->values[(size_t)source * matrix->numTargets + target];
+}
+
+#endif // MATRIX_H
@@ -0,0 +1,370 @@
+/**
+ * Pareto Route Search Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Multi-criteria label-setting search over (distance, time, cost). Each
+ * city keeps a bag of labels, one per non-dominated way of reaching it;
+ * labels leave the queue in lexicographic order of cost plus an exact
+ * per-criterion lower bound to the target, so every label is final when
+ * it is expanded and every target label is Pareto-optimal.
+ *
+ * Pruning: a label is dropped when a label at the same city or a route
+ * already found is at least as good on all three criteria (the latter
+ * after adding the lower bounds), and labels it dominates are dropped in
+ * turn. Labels live in one growable array of 24-byte records that link
+ * to their parent label, so paths are only built for the final routes.
+ */
+
+#include "pareto.h"
+
+#define LABEL_DEAD -2
+
+// One way of reaching a city
+typedef struct {
+    int cost[METRIC_COUNT];   // distance, time weight, cost so far
+    int edge;                 // CSR edge into the city, -1 at start, LABEL_DEAD once dominated
+    int parent;               // label the edge extends
+    int next;                 // next label in the same city's bag
+} Label;
+
+typedef struct {
+    int key[METRIC_COUNT];    // label cost plus lower bound to the target
+    int label;
+} QueueEntry;
+
+typedef struct {
+    const CSRGraph* csr;
+    int end;
+    int* bound[METRIC_COUNT]; // exact distance to end per criterion
+    int* bag;                 // first label of each city, -1 if none
+    Label* labels;
+    int numLabels;
+    int labelCapacity;
+    QueueEntry* queue;        // binary min-heap on key
+    int queueSize;
+    int queueCapacity;
+    int* found;               // labels at end, in queue order
+    int numFound;
+    int foundCapacity;
+    int (*stairs)[2];         // (time, cost) of found routes not beaten on both, time ascending
+    int numStairs;
+    int stairCapacity;
+} ParetoSearch;
+
+/**
+ * Double an array's capacity when it is full
+ */
+static bool ensureCapacity(void** array, int* capacity, int count, size_t itemSize) {
+    if (count < *capacity) return true;
+    
+    int newCapacity = *capacity > 0 ? *capacity * 2 : 256;
+    void* grown = realloc(*array, (size_t)newCapacity * itemSize);
+    if (!grown) {
+        fprintf(stderr, "Error: Memory allocation failed for Pareto labels\n");
+        return false;
+    }
+    *array = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+/**
+ * a is at least as good as b on every criterion
+ */
+static inline bool weaklyDominates(const int* a, const int* b) {
+    return a[0] <= b[0] && a[1] <= b[1] && a[2] <= b[2];
+}
+
+static inline bool keyLess(const int* a, const int* b) {
+    if (a[0] != b[0]) return a[0] < b[0];
+    if (a[1] != b[1]) return a[1] < b[1];
+    return a[2] < b[2];
+}
+
+static bool queuePush(ParetoSearch* search, const int* key, int label) {
+    if (!ensureCapacity((void**)&search->queue, &search->queueCapacity, search->queueSize,
+                        sizeof(QueueEntry))) {
+        return false;
+    }
+    
+    QueueEntry moving = {{key[0], key[1], key[2]}, label};
+    int slot = search->queueSize++;
+    while (slot > 0) {
+        int parentSlot = (slot - 1) / 2;
+        if (!keyLess(moving.key, search->queue[parentSlot].key)) break;
+        search->queue[slot] = search->queue[parentSlot];
+        slot = parentSlot;
+    }
+    search->queue[slot] = moving;
+    return true;
+}
+
+static QueueEntry queuePop(ParetoSearch* search) {
+    QueueEntry top = search->queue[0];
+    QueueEntry moving = search->queue[--search->queueSize];
+    int slot = 0;
+    
+    while (true) {
+        int child = slot * 2 + 1;
+        if (child >= search->queueSize) break;
+        if (child + 1 < search->queueSize &&
+            keyLess(search->queue[child + 1].key, search->queue[child].key)) {
+            child++;
+        }
+        if (!keyLess(search->queue[child].key, moving.key)) break;
+        search->queue[slot] = search->queue[child];
+        slot = child;
+    }
+    if (search->queueSize > 0) search->queue[slot] = moving;
+    return top;
+}
+
+/**
+ * Last stair with time <= the given time, -1 if none
+ */
+static int findStair(const ParetoSearch* search, int time) {
+    int low = 0, high = search->numStairs - 1, found = -1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (search->stairs[mid][0] <= time) {
+            found = mid;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return found;
+}
+
+/**
+ * A route already found is at least as good as anything this key can
+ * become. Keys leave the queue in distance order and the bounds are exact,
+ * so every found route is already no longer than the key: only time and
+ * cost need comparing, and the best cost up to a time is one binary search.
+ */
+static bool dominatedByFound(const ParetoSearch* search, const int* key) {
+    int stair = findStair(search, key[METRIC_TIME]);
+    return stair != -1 && search->stairs[stair][1] <= key[METRIC_COST];
+}
+
+/**
+ * Record a route reaching end
+ */
+static bool addFound(ParetoSearch* search, int id) {
+    if (!ensureCapacity((void**)&search->found, &search->foundCapacity, search->numFound,
+                        sizeof(int))) {
+        return false;
+    }
+    search->found[search->numFound++] = id;
+    
+    const int* cost = search->labels[id].cost;
+    if (dominatedByFound(search, cost)) return true;
+    if (!ensureCapacity((void**)&search->stairs, &search->stairCapacity, search->numStairs,
+                        sizeof(search->stairs[0]))) {
+        return false;
+    }
+    
+    // Drop the stairs from here on that are no cheaper, then insert
+    int slot = findStair(search, cost[METRIC_TIME]);
+    if (slot == -1 || search->stairs[slot][0] < cost[METRIC_TIME]) slot++;
+    int end = slot;
+    while (end < search->numStairs && search->stairs[end][1] >= cost[METRIC_COST]) end++;
+    memmove(&search->stairs[slot + 1], &search->stairs[end],
+            (search->numStairs - end) * sizeof(search->stairs[0]));
+    search->numStairs += slot + 1 - end;
+    search->stairs[slot][0] = cost[METRIC_TIME];
+    search->stairs[slot][1] = cost[METRIC_COST];
+    return true;
+}
+
+/**
+ * Offer a new label for city: dropped if dominated, otherwise it replaces
+ * the labels it dominates and is queued. Returns false on allocation failure.
+ */
+static bool offerLabel(ParetoSearch* search, int city, const int* cost, int edge, int parent) {
+    int key[METRIC_COUNT];
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        if (search->bound[m][city] == INFINITY_DIST) return true;
+        key[m] = cost[m] + search->bound[m][city];
+    }
+    if (dominatedByFound(search, key)) return true;
+    
+    int* link = &search->bag[city];
+    while (*link != -1) {
+        Label* other = &search->labels[*link];
+        if (weaklyDominates(other->cost, cost)) return true;
+        if (weaklyDominates(cost, other->cost)) {
+            // Only queued labels can be beaten, so nothing points at it yet
+            other->edge = LABEL_DEAD;
+            *link = other->next;
+        } else {
+            link = &other->next;
+        }
+    }
+    
+    if (!ensureCapacity((void**)&search->labels, &search->labelCapacity, search->numLabels,
+                        sizeof(Label))) {
+        return false;
+    }
+    int id = search->numLabels++;
+    Label* label = &search->labels[id];
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        label->cost[m] = cost[m];
+    }
+    label->edge = edge;
+    label->parent = parent;
+    label->next = search->bag[city];
+    search->bag[city] = id;
+    return queuePush(search, key, id);
+}
+
+/**
+ * PathResult for a label, following parent labels back to start
+ */
+static PathResult* buildLabelPath(const ParetoSearch* search, int start, int id) {
+    int numEdges = 0;
+    for (int l = id; search->labels[l].edge != -1; l = search->labels[l].parent) {
+        numEdges++;
+    }
+    
+    int* edges = (int*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(int));
+    if (!edges) return NULL;
+    int i = numEdges;
+    for (int l = id; search->labels[l].edge != -1; l = search->labels[l].parent) {
+        edges[--i] = search->labels[l].edge;
+    }
+    
+    PathResult* result = buildPathFromEdges(search->csr, start, edges, numEdges, "Pareto");
+    free(edges);
+    return result;
+}
+
+/**
+ * Exact lower bounds: one backward Dijkstra from end per criterion
+ */
+static bool computeBounds(Graph* graph, QueryContext* ctx, ParetoSearch* search) {
+    int n = search->csr->numCities;
+    
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        search->bound[m] = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        if (!search->bound[m] || !dijkstraOneToAll(graph, ctx, search->end, (WeightMetric)m, true)) {
+            return false;
+        }
+        for (int city = 0; city < n; city++) {
+            search->bound[m][city] = queryDistance(ctx, city);
+        }
+    }
+    return true;
+}
+
+static void freeSearch(ParetoSearch* search) {
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        free(search->bound[m]);
+    }
+    free(search->bag);
+    free(search->labels);
+    free(search->queue);
+    free(search->found);
+    free(search->stairs);
+}
+
+/**
+ * All Pareto-optimal routes from start to end over distance, time and cost.
+ * ctx is used for the lower-bound searches. maxLabels <= 0 uses
+ * PARETO_DEFAULT_MAX_LABELS. Returns NULL on invalid input or allocation
+ * failure; an unreachable end gives an empty set.
+ */
+ParetoSet* paretoQuery(Graph* graph, QueryContext* ctx, int start, int end, int maxLabels) {
+    const CSRGraph* csr = freezeGraph(graph);
+    if (!csr || start < 0 || end < 0 || start >= csr->numCities || end >= csr->numCities) {
+        return NULL;
+    }
+    if (maxLabels <= 0) maxLabels = PARETO_DEFAULT_MAX_LABELS;
+    
+    ParetoSearch search;
+    memset(&search, 0, sizeof(search));
+    search.csr = csr;
+    search.end = end;
+    ParetoSet* set = (ParetoSet*)calloc(1, sizeof(ParetoSet));
+    search.bag = (int*)malloc((csr->numCities > 0 ? csr->numCities : 1) * sizeof(int));
+    bool ok = set && search.bag && computeBounds(graph, ctx, &search);
+    
+    if (ok) {
+        for (int city = 0; city < csr->numCities; city++) {
+            search.bag[city] = -1;
+        }
+        int zero[METRIC_COUNT] = {0, 0, 0};
+        ok = offerLabel(&search, start, zero, -1, -1);
+    }
+    
+    while (ok && search.queueSize > 0) {
+        QueueEntry entry = queuePop(&search);
+        int id = entry.label;
+        if (search.labels[id].edge == LABEL_DEAD) continue;
+        int city = search.labels[id].edge == -1 ? start : csr->target[search.labels[id].edge];
+        
+        if (city == end) {
+            ok = addFound(&search, id);
+            continue;
+        }
+        if (dominatedByFound(&search, entry.key)) continue;
+        
+        if (search.numLabels >= maxLabels) {
+            set->truncated = true;
+            break;
+        }
+        for (int e = csr->offsets[city]; ok && e < csr->offsets[city + 1]; e++) {
+            const int* cost = search.labels[id].cost;
+            int next[METRIC_COUNT] = {
+                cost[METRIC_DISTANCE] + csr->distance[e],
+                cost[METRIC_TIME] + csr->timeWeight[e],
+                cost[METRIC_COST] + csr->cost[e]
+            };
+            ok = offerLabel(&search, csr->target[e], next, e, id);
+        }
+    }
+    
+    if (ok) {
+        set->numLabels = search.numLabels;
+        set->results = (PathResult**)malloc((search.numFound > 0 ? search.numFound : 1) *
+                                            sizeof(PathResult*));
+        ok = set->results != NULL;
+        for (int i = 0; ok && i < search.numFound; i++) {
+            set->results[i] = buildLabelPath(&search, start, search.found[i]);
+            ok = set->results[i] != NULL;
+            if (ok) set->numResults++;
+        }
+    }
+    
+    freeSearch(&search);
+    if (!ok) {
+        destroyParetoSet(set);
+        return NULL;
+    }
+    return set;
+}
+
+ParetoSet* paretoRoutes(Graph* graph, const char* startId, const char* endId) {
+    int start = findCityIndex(graph, startId);
+    int end = findCityIndex(graph, endId);
+    
+    if (start == -1 || end == -1) {
+        return NULL;
+    }
+    
+    QueryContext* ctx = getGraphQueryContext(graph, false);
+    if (!ctx) return NULL;
+    return paretoQuery(graph, ctx, start, end, 0);
+}
+
+/**
+ * Destroy a Pareto set and every route in it
+ */
+void destroyParetoSet(ParetoSet* set) {
+    if (!set) return;
+    for (int i = 0; i < set->numResults; i++) {
+        destroyPathResult(set->results[i]);
+    }
+    free(set->results);
+    free(set);
+}
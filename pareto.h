@@ -0,0 +1,29 @@
+/**
+ * Pareto Route Search Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef PARETO_H
+#define PARETO_H
+
+#include "graph.h"
+#include "query.h"
+
+// Labels kept per query before the search gives up (truncated = true)
+#define PARETO_DEFAULT_MAX_LABELS (4 << 20)
+
+// Every route that no other route beats on distance, time and cost at once,
+// ordered by distance (then time, then cost). Routes with identical totals
+// are reported once.
+typedef struct {
+    int numResults;
+    PathResult** results;
+    bool truncated;           // label limit hit: the set may be incomplete
+    int numLabels;            // labels created by the search
+} ParetoSet;
+
+ParetoSet* paretoRoutes(Graph* graph, const char* startId, const char* endId);
+ParetoSet* paretoQuery(Graph* graph, QueryContext* ctx, int start, int end, int maxLabels);
+void destroyParetoSet(ParetoSet* set);
+
+#endif // PARETO_H
@@ -0,0 +1,101 @@
+/**
+ * Query Context Implementation
+ * Travel Route Planner - C Implementation
+ */
+
+#include "query.h"
+
+/**
+ * Allocate the context arrays in one block for `capacity` cities
+ */
+static bool allocContextArrays(QueryContext* ctx, int capacity) {
+    size_t count = capacity > 0 ? (size_t)capacity : 1;
+    void* memory = malloc(count * (sizeof(HeapEntry) + 2 * sizeof(unsigned int) +
+                                   7 * sizeof(int)));
+    if (!memory) return false;
+    
+    free(ctx->memory);
+    ctx->memory = memory;
+    ctx->capacity = capacity;
+    
+    HeapEntry* entries = (HeapEntry*)memory;
+    ctx->stamp = (unsigned int*)(entries + count);
+    ctx->settled = ctx->stamp + count;
+    int* ints = (int*)(ctx->settled + count);
+    ctx->dist = ints;
+    ctx->score = ints + count;
+    ctx->parent = ints + 2 * count;
+    ctx->parentEdge = ints + 3 * count;
+    ctx->cursor = ints + 4 * count;
+    ctx->scratch = ints + 5 * count;
+    initMinHeap(&ctx->heap, entries, ints + 6 * count, capacity);
+    
+    // Generation 0 is never current, so zeroed stamps mean "untouched"
+    memset(ctx->stamp, 0, 2 * count * sizeof(unsigned int));
+    ctx->generation = 0;
+    return true;
+}
+
+/**
+ * Create a query context for graphs of up to `capacity` cities
+ */
+QueryContext* createQueryContext(int capacity) {
+    QueryContext* ctx = (QueryContext*)calloc(1, sizeof(QueryContext));
+    if (!ctx) {
+        fprintf(stderr, "Error: Memory allocation failed for query context\n");
+        return NULL;
+    }
+    
+    if (!allocContextArrays(ctx, capacity)) {
+        fprintf(stderr, "Error: Memory allocation failed for query context\n");
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+/**
+ * Destroy query context and free memory
+ */
+void destroyQueryContext(QueryContext* ctx) {
+    if (!ctx) return;
+    free(ctx->memory);
+    free(ctx);
+}
+
+/**
+ * Contexts owned by the graph for the string-ID API (created on first use,
+ * not thread-safe). `backward` selects the second half of two-sided searches.
+ */
+QueryContext* getGraphQueryContext(Graph* graph, bool backward) {
+    QueryContext** slot = backward ? &graph->reverseQueryContext : &graph->queryContext;
+    if (!*slot) {
+        *slot = createQueryContext(graph->numCities);
+    }
+    return *slot;
+}
+
+/**
+ * Start a new query: O(1) unless the graph outgrew the context or the
+ * generation counter wrapped
+ */
+bool beginQuery(QueryContext* ctx, int numCities) {
+    if (numCities > ctx->capacity) {
+        int capacity = ctx->capacity > 0 ? ctx->capacity : 1;
+        while (capacity < numCities) {
+            capacity *= 2;
+        }
+        if (!allocContextArrays(ctx, capacity)) return false;
+    }
+    
+    heapClear(&ctx->heap);
+    ctx->numSettled = 0;
+    
+    ctx->generation++;
+    if (ctx->generation == 0) {
+        memset(ctx->stamp, 0, ctx->capacity * sizeof(unsigned int));
+        memset(ctx->settled, 0, ctx->capacity * sizeof(unsigned int));
+        ctx->generation = 1;
+    }
+    return true;
+}
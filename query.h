@@ -0,0 +1,81 @@
+/**
+ * Query Context Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include "graph.h"
+#include "heap.h"
+
+// Reusable per-query search state. A city's dist/score/parent are only
+// meaningful when stamp[city] == generation, so starting a query is a
+// counter bump instead of an O(V) reset. One context per thread.
+struct QueryContext {
+    void* memory;             // single block backing every array below
+    int capacity;
+    unsigned int generation;
+    int numSettled;           // cities visited by the current query
+    unsigned int* stamp;      // generation in which dist/score/parent were set
+    unsigned int* settled;    // generation in which the city was visited
+    int* dist;                // dist (Dijkstra) / gScore (A*)
+    int* score;               // fScore (A*)
+    int* parent;
+    int* parentEdge;          // CSR edge that reached the city
+    int* cursor;              // next edge to try per city (DFS)
+    int* scratch;             // queue (BFS) / stack (DFS), not stamped
+    MinHeap heap;
+};
+
+QueryContext* createQueryContext(int capacity);
+QueryContext* getGraphQueryContext(Graph* graph, bool backward);
+void destroyQueryContext(QueryContext* ctx);
+bool beginQuery(QueryContext* ctx, int numCities);
+
+/**
+ * Make a city's dist/score/parent valid for the current query
+ */
+static inline void touchCity(QueryContext* ctx, int city) {
+    if (ctx->stamp[city] != ctx->generation) {
+        ctx->stamp[city] = ctx->generation;
+        ctx->dist[city] = INFINITY_DIST;
+        ctx->score[city] = INFINITY_DIST;
+        ctx->parent[city] = -1;
+        ctx->parentEdge[city] = -1;
+    }
+}
+
+static inline bool isVisited(const QueryContext* ctx, int city) {
+    return ctx->settled[city] == ctx->generation;
+}
+
+static inline void markVisited(QueryContext* ctx, int city) {
+    ctx->settled[city] = ctx->generation;
+    ctx->numSettled++;
+}
+
+/**
+ * Distance settled for a city by the current query, INFINITY_DIST if unreached
+ */
+static inline int queryDistance(const QueryContext* ctx, int city) {
+    return ctx->stamp[city] == ctx->generation ? ctx->dist[city] : INFINITY_DIST;
+}
+
+// Index-based searches over an explicit context (thread-safe on a frozen graph)
+// (modes: allowed transport modes, MODE_MASK_ALL for every edge)
+PathResult* dijkstraQuery(Graph* graph, QueryContext* ctx, int start, int end, WeightMetric metric,
+                          ModeMask modes);
+PathResult* aStarQuery(Graph* graph, QueryContext* ctx, int start, int end, WeightMetric metric,
+                       ModeMask modes);
+PathResult* bfsQuery(Graph* graph, QueryContext* ctx, int start, int end, ModeMask modes);
+PathResult* dfsQuery(Graph* graph, QueryContext* ctx, int start, int end, ModeMask modes);
+bool dijkstraOneToAll(Graph* graph, QueryContext* ctx, int source, WeightMetric metric, bool reverse);
+PathResult* bidirectionalDijkstraQuery(Graph* graph, QueryContext* forward, QueryContext* backward,
+                                       int start, int end, WeightMetric metric, ModeMask modes);
+
+// Build a result from a chain of CSR edge ids leaving `start`
+PathResult* buildPathFromEdges(const CSRGraph* csr, int start, const int* edges, int numEdges,
+                               const char* algorithm);
+
+#endif // QUERY_H
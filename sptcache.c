@@ -0,0 +1,427 @@
+/**
+ * Shortest-Path Tree Cache Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Slots hold whole one-to-all trees on an intrusive doubly linked LRU list
+ * and slotOf maps (metric, source) to a slot in O(1). A miss runs
+ * dijkstraOneToAll in the caller's context and copies the tree into a new
+ * block without holding the lock, so threads only serialize on list
+ * updates and path walks.
+ *
+ * sptCacheUpdateRoute keeps trees across weight changes: a heavier tree
+ * edge only invalidates the subtree below it, a lighter edge only starts a
+ * search from its head, and cities the change cannot affect are never
+ * visited.
+ */
+
+#include "sptcache.h"
+
+// CSR edge whose weights an update is about to change
+typedef struct {
+    int edge;
+    int source;
+    int oldWeight[METRIC_COUNT];
+} ChangedEdge;
+
+static void unlinkSlot(SPTCache* cache, int slot) {
+    CachedTree* tree = &cache->slots[slot];
+    if (tree->prev != -1) cache->slots[tree->prev].next = tree->next;
+    else cache->head = tree->next;
+    if (tree->next != -1) cache->slots[tree->next].prev = tree->prev;
+    else cache->tail = tree->prev;
+    tree->prev = tree->next = -1;
+}
+
+static void pushFront(SPTCache* cache, int slot) {
+    CachedTree* tree = &cache->slots[slot];
+    tree->prev = -1;
+    tree->next = cache->head;
+    if (cache->head != -1) cache->slots[cache->head].prev = slot;
+    cache->head = slot;
+    if (cache->tail == -1) cache->tail = slot;
+}
+
+/**
+ * Free every tree (lock held). Returns how many there were.
+ */
+static int dropTrees(SPTCache* cache) {
+    int dropped = cache->numTrees;
+    for (int slot = 0; slot < cache->numTrees; slot++) {
+        CachedTree* tree = &cache->slots[slot];
+        cache->slotOf[tree->metric][tree->source] = -1;
+        free(tree->dist);
+        tree->dist = tree->parent = tree->parentEdge = NULL;
+        tree->source = -1;
+        tree->prev = tree->next = -1;
+    }
+    cache->numTrees = 0;
+    cache->head = cache->tail = -1;
+    return dropped;
+}
+
+/**
+ * Drop trees built on an older graph version and make room for new
+ * cities (lock held)
+ */
+static bool syncVersion(SPTCache* cache) {
+    Graph* graph = cache->graph;
+    if (cache->graphVersion == graph->version) return true;
+    
+    cache->invalidations += dropTrees(cache);
+    if (graph->numCities > cache->numCities) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            int* grown = (int*)realloc(cache->slotOf[m], graph->numCities * sizeof(int));
+            if (!grown) {
+                fprintf(stderr, "Error: Memory allocation failed for tree cache\n");
+                return false;
+            }
+            for (int city = cache->numCities; city < graph->numCities; city++) {
+                grown[city] = -1;
+            }
+            cache->slotOf[m] = grown;
+        }
+        cache->numCities = graph->numCities;
+    }
+    cache->graphVersion = graph->version;
+    return true;
+}
+
+/**
+ * Create a cache of up to capacity trees (<= 0: SPT_CACHE_DEFAULT_CAPACITY)
+ */
+SPTCache* createSPTCache(Graph* graph, int capacity) {
+    if (!graph) return NULL;
+    if (capacity <= 0) capacity = SPT_CACHE_DEFAULT_CAPACITY;
+    
+    SPTCache* cache = (SPTCache*)calloc(1, sizeof(SPTCache));
+    if (!cache) {
+        fprintf(stderr, "Error: Memory allocation failed for tree cache\n");
+        return NULL;
+    }
+    int n = graph->numCities > 0 ? graph->numCities : 1;
+    cache->graph = graph;
+    cache->graphVersion = graph->version;
+    cache->numCities = n;
+    cache->capacity = capacity;
+    cache->head = cache->tail = -1;
+    cache->slots = (CachedTree*)calloc(capacity, sizeof(CachedTree));
+    bool ok = cache->slots != NULL;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        cache->slotOf[m] = (int*)malloc(n * sizeof(int));
+        ok = ok && cache->slotOf[m] != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for tree cache\n");
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            free(cache->slotOf[m]);
+        }
+        free(cache->slots);
+        free(cache);
+        return NULL;
+    }
+    
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        for (int city = 0; city < n; city++) {
+            cache->slotOf[m][city] = -1;
+        }
+    }
+    for (int slot = 0; slot < capacity; slot++) {
+        cache->slots[slot].source = -1;
+        cache->slots[slot].prev = cache->slots[slot].next = -1;
+    }
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void destroySPTCache(SPTCache* cache) {
+    if (!cache) return;
+    dropTrees(cache);
+    pthread_mutex_destroy(&cache->lock);
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        free(cache->slotOf[m]);
+    }
+    free(cache->slots);
+    free(cache);
+}
+
+/**
+ * Drop every cached tree; the counters are kept
+ */
+void clearSPTCache(SPTCache* cache) {
+    pthread_mutex_lock(&cache->lock);
+    dropTrees(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * Slot of the (start, metric) tree, built with ctx on a miss. On success
+ * the lock is still held and the slot is most recently used; -1 on
+ * allocation failure (lock released).
+ */
+static int acquireTree(SPTCache* cache, QueryContext* ctx, int start, WeightMetric metric) {
+    pthread_mutex_lock(&cache->lock);
+    if (!syncVersion(cache)) {
+        pthread_mutex_unlock(&cache->lock);
+        return -1;
+    }
+    int slot = cache->slotOf[metric][start];
+    if (slot != -1) {
+        cache->hits++;
+        unlinkSlot(cache, slot);
+        pushFront(cache, slot);
+        return slot;
+    }
+    cache->misses++;
+    pthread_mutex_unlock(&cache->lock);
+    
+    // Search and copy without the lock
+    int n = cache->graph->numCities;
+    int* block = (int*)malloc(3 * (size_t)n * sizeof(int));
+    if (!block || !dijkstraOneToAll(cache->graph, ctx, start, metric, false)) {
+        fprintf(stderr, "Error: Memory allocation failed for tree cache\n");
+        free(block);
+        return -1;
+    }
+    for (int city = 0; city < n; city++) {
+        bool reached = ctx->stamp[city] == ctx->generation;
+        block[city] = reached ? ctx->dist[city] : INFINITY_DIST;
+        block[n + city] = reached ? ctx->parent[city] : -1;
+        block[2 * n + city] = reached ? ctx->parentEdge[city] : -1;
+    }
+    
+    pthread_mutex_lock(&cache->lock);
+    slot = cache->slotOf[metric][start];
+    if (slot != -1) {
+        // Another thread cached the same tree meanwhile
+        free(block);
+        unlinkSlot(cache, slot);
+        pushFront(cache, slot);
+        return slot;
+    }
+    
+    int* evicted = NULL;
+    if (cache->numTrees == cache->capacity) {
+        slot = cache->tail;
+        CachedTree* old = &cache->slots[slot];
+        unlinkSlot(cache, slot);
+        cache->slotOf[old->metric][old->source] = -1;
+        evicted = old->dist;
+        cache->evictions++;
+    } else {
+        slot = cache->numTrees++;   // trees only leave by eviction or all at once
+    }
+    CachedTree* tree = &cache->slots[slot];
+    tree->source = start;
+    tree->metric = metric;
+    tree->dist = block;
+    tree->parent = block + n;
+    tree->parentEdge = block + 2 * (size_t)n;
+    cache->slotOf[metric][start] = slot;
+    pushFront(cache, slot);
+    free(evicted);
+    return slot;
+}
+
+/**
+ * Shortest path start -> end from the cached tree of start, the same path
+ * dijkstraQuery returns (after a repair, possibly another one of equal
+ * weight). ctx builds the tree on a miss. NULL if there is no path.
+ */
+PathResult* sptCacheQuery(SPTCache* cache, QueryContext* ctx, int start, int end,
+                          WeightMetric metric) {
+    const CSRGraph* csr = freezeGraph(cache->graph);
+    if (!csr || start < 0 || end < 0 || start >= csr->numCities || end >= csr->numCities ||
+        !beginQuery(ctx, csr->numCities)) {
+        return NULL;
+    }
+    
+    int slot = acquireTree(cache, ctx, start, metric);
+    if (slot == -1) return NULL;
+    
+    // Copy the edge chain under the lock, build the result after
+    const CachedTree* tree = &cache->slots[slot];
+    bool reachable = tree->dist[end] != INFINITY_DIST;
+    int numEdges = 0;
+    for (int city = end; reachable && city != start; city = tree->parent[city]) {
+        numEdges++;
+    }
+    int* edges = ctx->scratch;
+    int i = numEdges;
+    for (int city = end; reachable && city != start; city = tree->parent[city]) {
+        edges[--i] = tree->parentEdge[city];
+    }
+    pthread_mutex_unlock(&cache->lock);
+    
+    if (!reachable) return NULL;
+    return buildPathFromEdges(csr, start, edges, numEdges, "Dijkstra's Algorithm");
+}
+
+/**
+ * Shortest-path weight start -> end from the cached tree of start,
+ * INFINITY_DIST if unreachable, -1 on invalid input
+ */
+int sptCacheDistance(SPTCache* cache, QueryContext* ctx, int start, int end, WeightMetric metric) {
+    const CSRGraph* csr = freezeGraph(cache->graph);
+    if (!csr || start < 0 || end < 0 || start >= csr->numCities || end >= csr->numCities) {
+        return -1;
+    }
+    
+    int slot = acquireTree(cache, ctx, start, metric);
+    if (slot == -1) return -1;
+    int dist = cache->slots[slot].dist[end];
+    pthread_mutex_unlock(&cache->lock);
+    return dist;
+}
+
+static inline void relaxTreeEdge(CachedTree* tree, MinHeap* pq, const int* weights,
+                                 int from, int e, int to) {
+    int newDist = tree->dist[from] + weights[e];
+    if (newDist < tree->dist[to]) {
+        tree->dist[to] = newDist;
+        tree->parent[to] = from;
+        tree->parentEdge[to] = e;
+        heapPushOrDecrease(pq, to, newDist);
+    }
+}
+
+/**
+ * Bring one tree up to date after the changed edges got their new weights
+ * (lock held). Cities below a tree edge that got heavier lose their
+ * distance and are re-seeded from incoming edges outside that subtree;
+ * every lighter edge seeds its head. A Dijkstra pass from the seeds then
+ * settles exactly the cities whose distance moved. Returns how many.
+ */
+static int repairTree(CachedTree* tree, const CSRGraph* csr, QueryContext* ctx,
+                      const ChangedEdge* changed, int numChanged) {
+    if (!beginQuery(ctx, csr->numCities)) return 0;
+    const int* weights = csrWeights(csr, tree->metric);
+    MinHeap* pq = &ctx->heap;
+    
+    // Subtrees hanging off heavier tree edges; visited marks membership
+    int* affected = ctx->scratch;
+    int numAffected = 0;
+    for (int c = 0; c < numChanged; c++) {
+        int e = changed[c].edge;
+        int head = csr->target[e];
+        if (tree->parentEdge[head] == e && weights[e] > changed[c].oldWeight[tree->metric] &&
+            !isVisited(ctx, head)) {
+            markVisited(ctx, head);
+            affected[numAffected++] = head;
+        }
+    }
+    for (int i = 0; i < numAffected; i++) {
+        int city = affected[i];
+        for (int e = csr->offsets[city]; e < csr->offsets[city + 1]; e++) {
+            int child = csr->target[e];
+            if (tree->parentEdge[child] == e && !isVisited(ctx, child)) {
+                markVisited(ctx, child);
+                affected[numAffected++] = child;
+            }
+        }
+    }
+    for (int i = 0; i < numAffected; i++) {
+        int city = affected[i];
+        tree->dist[city] = INFINITY_DIST;
+        tree->parent[city] = -1;
+        tree->parentEdge[city] = -1;
+    }
+    
+    // Seeds: best entry into each invalidated city, and the lighter edges
+    for (int i = 0; i < numAffected; i++) {
+        int city = affected[i];
+        for (int r = csr->revOffsets[city]; r < csr->revOffsets[city + 1]; r++) {
+            int from = csr->revSource[r];
+            if (isVisited(ctx, from) || tree->dist[from] == INFINITY_DIST) continue;
+            relaxTreeEdge(tree, pq, weights, from, csr->revEdge[r], city);
+        }
+    }
+    for (int c = 0; c < numChanged; c++) {
+        int from = changed[c].source;
+        if (tree->dist[from] == INFINITY_DIST) continue;
+        relaxTreeEdge(tree, pq, weights, from, changed[c].edge, csr->target[changed[c].edge]);
+    }
+    
+    // Every other distance is still an upper bound, so this settles each
+    // improved city once
+    int settled = 0;
+    while (!heapIsEmpty(pq)) {
+        int city = heapPopMin(pq);
+        settled++;
+        for (int e = csr->offsets[city]; e < csr->offsets[city + 1]; e++) {
+            relaxTreeEdge(tree, pq, weights, city, e, csr->target[e]);
+        }
+    }
+    return settled;
+}
+
+/**
+ * updateRoute that keeps the cached trees: each is repaired in place
+ * instead of being dropped. ctx is scratch space for the repairs. Returns
+ * updateRoute's result (edges changed, -1 if there is no such route).
+ */
+int sptCacheUpdateRoute(SPTCache* cache, QueryContext* ctx, const char* from, const char* to,
+                        const char* mode, int newDistance, double newTime, int newCost) {
+    Graph* graph = cache->graph;
+    const CSRGraph* csr = freezeGraph(graph);
+    int fromIndex = findCityIndex(graph, from);
+    int toIndex = findCityIndex(graph, to);
+    int modeId = findModeId(graph, mode);
+    if (!csr || graph->mapping || fromIndex == -1 || toIndex == -1 || modeId == -1) {
+        return updateRoute(graph, from, to, mode, newDistance, newTime, newCost);
+    }
+    
+    // Same edges updateRoute changes, with their weights before the change
+    int numChanged = 0;
+    ChangedEdge* changed = NULL;
+    for (int fill = 0; fill < 2; fill++) {
+        numChanged = 0;
+        for (int pass = 0; pass < 2; pass++) {
+            int u = pass == 0 ? fromIndex : toIndex;
+            int v = pass == 0 ? toIndex : fromIndex;
+            if (pass == 1 && (graph->isDirected || u == v)) break;
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                if (csr->target[e] != v || csr->modeId[e] != modeId) continue;
+                if (changed) {
+                    changed[numChanged].edge = e;
+                    changed[numChanged].source = u;
+                    for (int m = 0; m < METRIC_COUNT; m++) {
+                        changed[numChanged].oldWeight[m] = csrWeights(csr, (WeightMetric)m)[e];
+                    }
+                }
+                numChanged++;
+            }
+        }
+        if (numChanged == 0 || changed) break;
+        changed = (ChangedEdge*)malloc(numChanged * sizeof(ChangedEdge));
+        if (!changed) {
+            fprintf(stderr, "Error: Memory allocation failed for tree cache\n");
+            break;
+        }
+    }
+    
+    pthread_mutex_lock(&cache->lock);
+    bool current = changed && syncVersion(cache);
+    int result = updateRoute(graph, from, to, mode, newDistance, newTime, newCost);
+    if (current && result > 0) {
+        for (int slot = 0; slot < cache->numTrees; slot++) {
+            cache->repairedCities += repairTree(&cache->slots[slot], csr, ctx, changed, numChanged);
+        }
+        cache->graphVersion = graph->version;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    
+    free(changed);
+    return result;
+}
+
+void getSPTCacheStats(SPTCache* cache, SPTCacheStats* stats) {
+    pthread_mutex_lock(&cache->lock);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->invalidations = cache->invalidations;
+    stats->repairedCities = cache->repairedCities;
+    stats->numTrees = cache->numTrees;
+    stats->capacity = cache->capacity;
+    pthread_mutex_unlock(&cache->lock);
+}
@@ -0,0 +1,69 @@
+/**
+ * Shortest-Path Tree Cache Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef SPTCACHE_H
+#define SPTCACHE_H
+
+#include <pthread.h>
+#include "graph.h"
+#include "query.h"
+
+#define SPT_CACHE_DEFAULT_CAPACITY 32
+
+// One-to-all Dijkstra tree of one (source, metric), numCities entries per array
+typedef struct {
+    int source;               // -1 for a free slot
+    WeightMetric metric;
+    int* dist;                // INFINITY_DIST when unreachable; one block with the two below
+    int* parent;              // previous city on the shortest path, -1 at source / unreached
+    int* parentEdge;          // CSR edge from parent
+    int prev;                 // LRU list neighbours (slot indices, -1 at the ends)
+    int next;
+} CachedTree;
+
+// LRU cache of whole shortest-path trees, so queries sharing an origin are
+// a walk up the tree instead of a new search. Trees belong to one graph
+// version: the first lookup after addCity/addRoute/updateRoute drops them
+// all, while sptCacheUpdateRoute repairs them in place.
+// Lookups are thread-safe; the graph must not change during them.
+typedef struct {
+    Graph* graph;
+    unsigned long graphVersion;   // version the cached trees were built on
+    int numCities;
+    int capacity;
+    int numTrees;
+    CachedTree* slots;
+    int* slotOf[METRIC_COUNT];    // source -> slot, -1 if not cached
+    int head;                     // most recently used slot
+    int tail;                     // least recently used slot
+    pthread_mutex_t lock;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;      // trees dropped to make room
+    unsigned long invalidations;  // trees dropped because the graph changed
+    unsigned long repairedCities; // cities re-settled by sptCacheUpdateRoute
+} SPTCache;
+
+typedef struct {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    unsigned long invalidations;
+    unsigned long repairedCities;
+    int numTrees;
+    int capacity;
+} SPTCacheStats;
+
+SPTCache* createSPTCache(Graph* graph, int capacity);
+void destroySPTCache(SPTCache* cache);
+void clearSPTCache(SPTCache* cache);
+PathResult* sptCacheQuery(SPTCache* cache, QueryContext* ctx, int start, int end,
+                          WeightMetric metric);
+int sptCacheDistance(SPTCache* cache, QueryContext* ctx, int start, int end, WeightMetric metric);
+int sptCacheUpdateRoute(SPTCache* cache, QueryContext* ctx, const char* from, const char* to,
+                        const char* mode, int newDistance, double newTime, int newCost);
+void getSPTCacheStats(SPTCache* cache, SPTCacheStats* stats);
+
+#endif // SPTCACHE_H
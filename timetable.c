@@ -0,0 +1,551 @@
+/**
+ * Timetable Implementation
+ * Travel Route Planner - C Implementation
+ *
+ * Connection Scan Algorithm (CSA): with all connections sorted by
+ * departure, an earliest-arrival query is one forward sweep from the first
+ * connection leaving after the requested time, and a profile query is one
+ * backward sweep. No priority queue is needed; the only state is one
+ * arrival time per city and one entry per trip.
+ */
+
+#include "timetable.h"
+
+/**
+ * Create an empty timetable over a graph's cities
+ */
+Timetable* createTimetable(Graph* graph) {
+    if (!graph) return NULL;
+    
+    Timetable* timetable = (Timetable*)calloc(1, sizeof(Timetable));
+    if (!timetable) {
+        fprintf(stderr, "Error: Memory allocation failed for timetable\n");
+        return NULL;
+    }
+    timetable->graph = graph;
+    timetable->transferMinutes = TIMETABLE_DEFAULT_TRANSFER;
+    timetable->sorted = true;
+    return timetable;
+}
+
+/**
+ * Destroy timetable and free memory
+ */
+void destroyTimetable(Timetable* timetable) {
+    if (!timetable) return;
+    free(timetable->connections);
+    free(timetable);
+}
+
+/**
+ * Append a connection by city index and mode id
+ */
+static bool appendConnection(Timetable* timetable, int from, int to, int departureTime,
+                             int arrivalTime, int trip, int modeId) {
+    if (timetable->numConnections == timetable->capacity) {
+        int capacity = timetable->capacity > 0 ? timetable->capacity * 2 : 1024;
+        Connection* grown = (Connection*)realloc(timetable->connections,
+                                                 capacity * sizeof(Connection));
+        if (!grown) {
+            fprintf(stderr, "Error: Memory allocation failed for connections\n");
+            return false;
+        }
+        timetable->connections = grown;
+        timetable->capacity = capacity;
+    }
+    
+    Connection* connection = &timetable->connections[timetable->numConnections++];
+    connection->departureTime = departureTime;
+    connection->arrivalTime = arrivalTime;
+    connection->from = from;
+    connection->to = to;
+    connection->trip = trip;
+    connection->modeId = (unsigned char)modeId;
+    
+    if (trip >= timetable->numTrips) timetable->numTrips = trip + 1;
+    timetable->sorted = false;
+    return true;
+}
+
+/**
+ * Add one hop of a trip. Connections may be added in any order; a trip's
+ * hops must follow each other in time. Returns the connection count, or -1
+ * for an unknown city, arrival before departure, negative trip or too many modes.
+ */
+int addConnection(Timetable* timetable, const char* fromId, const char* toId, int departureTime,
+                  int arrivalTime, int trip, const char* mode) {
+    if (!timetable) return -1;
+    
+    int from = findCityIndex(timetable->graph, fromId);
+    int to = findCityIndex(timetable->graph, toId);
+    if (from == -1 || to == -1 || arrivalTime < departureTime || departureTime < 0 || trip < 0) {
+        return -1;
+    }
+    
+    int modeId = 0;
+    while (modeId < timetable->numModes && strcmp(timetable->modeNames[modeId], mode) != 0) {
+        modeId++;
+    }
+    if (modeId == timetable->numModes) {
+        if (modeId == MAX_MODES || strlen(mode) >= sizeof(timetable->modeNames[0])) return -1;
+        strcpy(timetable->modeNames[timetable->numModes++], mode);
+    }
+    
+    if (!appendConnection(timetable, from, to, departureTime, arrivalTime, trip, modeId)) {
+        return -1;
+    }
+    return timetable->numConnections;
+}
+
+/**
+ * Minutes between departures of one service on a route
+ */
+static int serviceHeadway(const char* mode) {
+    if (strcmp(mode, "Flight") == 0) return 240;
+    if (strcmp(mode, "Bus") == 0) return 60;
+    return 120;
+}
+
+/**
+ * Timetable with a regular service on every route of the graph, departing
+ * between firstDeparture and lastDeparture (minutes) and taking the route's
+ * static time. Flights run every 4 hours, buses hourly and everything else
+ * every 2 hours; each departure is its own trip.
+ */
+Timetable* buildTimetableFromRoutes(Graph* graph, int firstDeparture, int lastDeparture) {
+    const CSRGraph* csr = freezeGraph(graph);
+    Timetable* timetable = csr ? createTimetable(graph) : NULL;
+    if (!timetable) return NULL;
+    
+    timetable->numModes = csr->numModes;
+    memcpy(timetable->modeNames, csr->modeNames, sizeof(csr->modeNames));
+    
+    int trip = 0;
+    for (int city = 0; city < csr->numCities; city++) {
+        for (int e = csr->offsets[city]; e < csr->offsets[city + 1]; e++) {
+            int headway = serviceHeadway(csr->modeNames[csr->modeId[e]]);
+            int duration = (int)lround(csr->time[e] * 60);
+            if (duration < 1) duration = 1;
+            
+            // Stagger services so they do not all leave on the hour
+            for (int t = firstDeparture + (e * 37) % headway; t <= lastDeparture; t += headway) {
+                if (!appendConnection(timetable, city, csr->target[e], t, t + duration, trip++,
+                                      csr->modeId[e])) {
+                    destroyTimetable(timetable);
+                    return NULL;
+                }
+            }
+        }
+    }
+    return timetable;
+}
+
+static bool connectionBefore(const Connection* a, const Connection* b) {
+    if (a->departureTime != b->departureTime) return a->departureTime < b->departureTime;
+    return a->arrivalTime < b->arrivalTime;
+}
+
+/**
+ * Stable bottom-up merge sort by departure, then arrival, so hops of one
+ * trip at the same minute keep the order they were added in
+ */
+static bool sortConnections(Timetable* timetable) {
+    if (timetable->sorted) return true;
+    
+    int n = timetable->numConnections;
+    Connection* buffer = (Connection*)malloc((n > 0 ? n : 1) * sizeof(Connection));
+    if (!buffer) {
+        fprintf(stderr, "Error: Memory allocation failed for connections\n");
+        return false;
+    }
+    
+    Connection* source = timetable->connections;
+    Connection* target = buffer;
+    for (int width = 1; width < n; width *= 2) {
+        for (int low = 0; low < n; low += 2 * width) {
+            int mid = low + width < n ? low + width : n;
+            int high = low + 2 * width < n ? low + 2 * width : n;
+            int i = low, j = mid, k = low;
+            while (i < mid && j < high) {
+                target[k++] = connectionBefore(&source[j], &source[i]) ? source[j++] : source[i++];
+            }
+            while (i < mid) target[k++] = source[i++];
+            while (j < high) target[k++] = source[j++];
+        }
+        Connection* swap = source;
+        source = target;
+        target = swap;
+    }
+    
+    if (source != timetable->connections) {
+        memcpy(timetable->connections, source, n * sizeof(Connection));
+    }
+    free(buffer);
+    timetable->sorted = true;
+    return true;
+}
+
+/**
+ * Index of the first connection departing at or after time
+ */
+static int firstConnectionAfter(const Timetable* timetable, int time) {
+    int low = 0, high = timetable->numConnections;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (timetable->connections[mid].departureTime < time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static bool validQuery(Timetable* timetable, int source, int target) {
+    return timetable && source >= 0 && target >= 0 && source < timetable->graph->numCities &&
+           target < timetable->graph->numCities && sortConnections(timetable);
+}
+
+/**
+ * Journey following the recorded boarding and alighting connections back
+ * from target
+ */
+static Journey* buildJourney(const Timetable* timetable, int source, int target, int departAfter,
+                             const int* enter, const int* exit) {
+    int numLegs = 0;
+    for (int city = target; city != source; city = timetable->connections[enter[city]].from) {
+        numLegs++;
+    }
+    
+    Journey* journey = (Journey*)malloc(sizeof(Journey));
+    if (!journey) return NULL;
+    journey->legs = (JourneyLeg*)malloc((numLegs > 0 ? numLegs : 1) * sizeof(JourneyLeg));
+    if (!journey->legs) {
+        free(journey);
+        return NULL;
+    }
+    journey->numLegs = numLegs;
+    
+    int i = numLegs;
+    for (int city = target; city != source; city = timetable->connections[enter[city]].from) {
+        const Connection* board = &timetable->connections[enter[city]];
+        const Connection* alight = &timetable->connections[exit[city]];
+        JourneyLeg* leg = &journey->legs[--i];
+        leg->from = board->from;
+        leg->to = alight->to;
+        leg->departureTime = board->departureTime;
+        leg->arrivalTime = alight->arrivalTime;
+        leg->trip = board->trip;
+        strcpy(leg->mode, timetable->modeNames[board->modeId]);
+    }
+    
+    journey->departureTime = numLegs > 0 ? journey->legs[0].departureTime : departAfter;
+    journey->arrivalTime = numLegs > 0 ? journey->legs[numLegs - 1].arrivalTime : departAfter;
+    return journey;
+}
+
+// Per-query state of a forward scan
+typedef struct {
+    int* arrival;             // earliest arrival per city
+    int* enter;               // connection where the last leg boarded
+    int* exit;                // connection that arrived
+    int* boarded;             // first connection used per trip, -1 if none
+} ScanState;
+
+static void freeScanState(ScanState* state) {
+    free(state->arrival);
+    free(state->enter);
+    free(state->exit);
+    free(state->boarded);
+}
+
+static bool allocScanState(const Timetable* timetable, ScanState* state) {
+    int n = timetable->graph->numCities;
+    state->arrival = (int*)malloc(n * sizeof(int));
+    state->enter = (int*)malloc(n * sizeof(int));
+    state->exit = (int*)malloc(n * sizeof(int));
+    state->boarded = (int*)malloc((timetable->numTrips > 0 ? timetable->numTrips : 1) * sizeof(int));
+    if (!state->arrival || !state->enter || !state->exit || !state->boarded) {
+        fprintf(stderr, "Error: Memory allocation failed for timetable query\n");
+        freeScanState(state);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Forward sweep from the first connection after departAfter. Trips are
+ * only boarded at source up to lastSourceDeparture. Returns the arrival
+ * time at target, INFINITY_DIST if unreachable.
+ */
+static int scanEarliest(const Timetable* timetable, ScanState* state, int source, int target,
+                        int departAfter, int lastSourceDeparture) {
+    int* arrival = state->arrival;
+    int* boarded = state->boarded;
+    for (int city = 0; city < timetable->graph->numCities; city++) {
+        arrival[city] = INFINITY_DIST;
+    }
+    for (int trip = 0; trip < timetable->numTrips; trip++) {
+        boarded[trip] = -1;
+    }
+    arrival[source] = departAfter;
+    
+    for (int i = firstConnectionAfter(timetable, departAfter); i < timetable->numConnections; i++) {
+        const Connection* c = &timetable->connections[i];
+        if (arrival[target] <= c->departureTime) break;   // nothing later can improve
+        
+        if (boarded[c->trip] == -1) {
+            int ready = arrival[c->from];
+            if (c->from == source) {
+                if (c->departureTime > lastSourceDeparture) continue;
+            } else if (ready != INFINITY_DIST) {
+                ready += timetable->transferMinutes;
+            }
+            if (ready > c->departureTime) continue;
+            boarded[c->trip] = i;
+        }
+        if (c->arrivalTime < arrival[c->to]) {
+            arrival[c->to] = c->arrivalTime;
+            state->enter[c->to] = boarded[c->trip];
+            state->exit[c->to] = i;
+        }
+    }
+    return arrival[target];
+}
+
+/**
+ * Earliest arrival at target when leaving source at or after departAfter.
+ * Changing trips needs transferMinutes, except at the start. Returns NULL
+ * if target cannot be reached.
+ */
+Journey* earliestArrival(Timetable* timetable, int source, int target, int departAfter) {
+    ScanState state;
+    if (!validQuery(timetable, source, target) || !allocScanState(timetable, &state)) return NULL;
+    
+    Journey* journey = NULL;
+    if (scanEarliest(timetable, &state, source, target, departAfter, INFINITY_DIST) != INFINITY_DIST) {
+        journey = buildJourney(timetable, source, target, departAfter, state.enter, state.exit);
+    }
+    freeScanState(&state);
+    return journey;
+}
+
+/**
+ * Latest useful arrival of a profile: the earliest arrival of journeys
+ * leaving with source's last departure in the window. A journey arriving
+ * later would be beaten by that one, so the backward sweep can start at
+ * this time. INFINITY_DIST if there is no such bound.
+ */
+static int profileHorizon(Timetable* timetable, int source, int target, int windowStart,
+                          int windowEnd) {
+    int lastDeparture = -1;
+    int first = firstConnectionAfter(timetable, windowStart);
+    for (int i = firstConnectionAfter(timetable, windowEnd + 1) - 1; i >= first; i--) {
+        if (timetable->connections[i].from == source) {
+            lastDeparture = timetable->connections[i].departureTime;
+            break;
+        }
+    }
+    if (lastDeparture == -1) return windowStart;   // no departures: nothing to scan
+    
+    ScanState state;
+    if (!allocScanState(timetable, &state)) return INFINITY_DIST;
+    int horizon = scanEarliest(timetable, &state, source, target, lastDeparture, windowEnd);
+    freeScanState(&state);
+    return horizon;
+}
+
+// Departure/arrival pairs of one city, latest departure first
+typedef struct {
+    ProfileEntry* entries;
+    int count;
+    int capacity;
+} ProfileList;
+
+/**
+ * Keep (departure, arrival) unless a later or equal departure already
+ * arrives no later. Pairs come in non-increasing departure order.
+ */
+static bool addProfileEntry(ProfileList* list, int departureTime, int arrivalTime) {
+    if (list->count > 0) {
+        ProfileEntry* last = &list->entries[list->count - 1];
+        if (last->arrivalTime <= arrivalTime) return true;
+        if (last->departureTime == departureTime) {
+            last->arrivalTime = arrivalTime;
+            return true;
+        }
+    }
+    
+    if (list->count == list->capacity) {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+        ProfileEntry* grown = (ProfileEntry*)realloc(list->entries, capacity * sizeof(ProfileEntry));
+        if (!grown) {
+            fprintf(stderr, "Error: Memory allocation failed for profile\n");
+            return false;
+        }
+        list->entries = grown;
+        list->capacity = capacity;
+    }
+    list->entries[list->count].departureTime = departureTime;
+    list->entries[list->count].arrivalTime = arrivalTime;
+    list->count++;
+    return true;
+}
+
+/**
+ * Earliest arrival from a city's list when ready to leave at time
+ */
+static int evaluateProfile(const ProfileList* list, int time) {
+    // Last entry (earliest arrival) among those departing at or after time
+    int low = 0, high = list->count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (list->entries[mid].departureTime >= time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low > 0 ? list->entries[low - 1].arrivalTime : INFINITY_DIST;
+}
+
+/**
+ * Every useful journey from source to target departing within
+ * [windowStart, windowEnd]: for each departure, the earliest arrival,
+ * keeping only departures that arrive strictly earlier than any later one.
+ * One backward sweep, from the horizon down to windowStart, computes the
+ * profiles of all cities at once.
+ */
+Profile* profileQuery(Timetable* timetable, int source, int target, int windowStart, int windowEnd) {
+    if (!validQuery(timetable, source, target)) return NULL;
+    
+    int n = timetable->graph->numCities;
+    ProfileList* lists = (ProfileList*)calloc(n, sizeof(ProfileList));
+    int* tripArrival = (int*)malloc((timetable->numTrips > 0 ? timetable->numTrips : 1) * sizeof(int));
+    ProfileList result = {NULL, 0, 0};
+    bool ok = lists && tripArrival;
+    
+    for (int trip = 0; ok && trip < timetable->numTrips; trip++) {
+        tripArrival[trip] = INFINITY_DIST;
+    }
+    
+    int first = ok ? firstConnectionAfter(timetable, windowStart) : 0;
+    int horizon = ok ? profileHorizon(timetable, source, target, windowStart, windowEnd) : 0;
+    int last = horizon == INFINITY_DIST ? timetable->numConnections - 1 :
+               firstConnectionAfter(timetable, horizon + 1) - 1;
+    for (int i = last; ok && i >= first; i--) {
+        const Connection* c = &timetable->connections[i];
+        
+        // Get off at target, stay on board, or change at the next city
+        int best = c->to == target ? c->arrivalTime : INFINITY_DIST;
+        if (tripArrival[c->trip] < best) best = tripArrival[c->trip];
+        if (c->to != target) {
+            int change = evaluateProfile(&lists[c->to], c->arrivalTime + timetable->transferMinutes);
+            if (change < best) best = change;
+        }
+        if (best == INFINITY_DIST) continue;
+        
+        tripArrival[c->trip] = best;
+        if (c->from == target) continue;
+        ok = addProfileEntry(&lists[c->from], c->departureTime, best);
+        
+        // The source's own list also holds departures after the window,
+        // which must not hide earlier ones inside it
+        if (ok && c->from == source && c->departureTime <= windowEnd) {
+            ok = addProfileEntry(&result, c->departureTime, best);
+        }
+    }
+    
+    Profile* profile = ok ? (Profile*)malloc(sizeof(Profile)) : NULL;
+    if (profile) {
+        // Latest-first list to ascending departure
+        for (int i = 0; i < result.count / 2; i++) {
+            ProfileEntry swap = result.entries[i];
+            result.entries[i] = result.entries[result.count - 1 - i];
+            result.entries[result.count - 1 - i] = swap;
+        }
+        profile->numEntries = result.count;
+        profile->entries = result.entries;
+    } else {
+        free(result.entries);
+    }
+    
+    for (int city = 0; lists && city < n; city++) {
+        free(lists[city].entries);
+    }
+    free(lists);
+    free(tripArrival);
+    return profile;
+}
+
+/**
+ * Destroy journey and free memory
+ */
+void destroyJourney(Journey* journey) {
+    if (!journey) return;
+    free(journey->legs);
+    free(journey);
+}
+
+/**
+ * Destroy profile and free memory
+ */
+void destroyProfile(Profile* profile) {
+    if (!profile) return;
+    free(profile->entries);
+    free(profile);
+}
+
+/**
+ * "HH:MM" (hours may exceed 23) to minutes, -1 if malformed
+ */
+int parseClockTime(const char* text) {
+    int hours, minutes;
+    char extra;
+    if (!text || sscanf(text, "%d:%d%c", &hours, &minutes, &extra) != 2 ||
+        hours < 0 || minutes < 0 || minutes > 59) {
+        return -1;
+    }
+    return hours * 60 + minutes;
+}
+
+/**
+ * Minutes to "HH:MM", with a "+Nd" suffix after the first day
+ */
+void formatClockTime(int minutes, char* buffer, size_t size) {
+    int days = minutes / MINUTES_PER_DAY;
+    int inDay = minutes % MINUTES_PER_DAY;
+    if (days > 0) {
+        snprintf(buffer, size, "%02d:%02d+%dd", inDay / 60, inDay % 60, days);
+    } else {
+        snprintf(buffer, size, "%02d:%02d", inDay / 60, inDay % 60);
+    }
+}
+
+/**
+ * Print a journey leg by leg
+ */
+void printJourney(const Timetable* timetable, const Journey* journey) {
+    if (!journey) {
+        printf("No connection found.\n");
+        return;
+    }
+    
+    char departure[16], arrival[16];
+    formatClockTime(journey->departureTime, departure, sizeof(departure));
+    formatClockTime(journey->arrivalTime, arrival, sizeof(arrival));
+    int duration = journey->arrivalTime - journey->departureTime;
+    
+    printf("\n=== Journey Found ===\n");
+    printf("Depart: %s   Arrive: %s   (%dh %02dm, %d leg%s)\n", departure, arrival,
+           duration / 60, duration % 60, journey->numLegs, journey->numLegs == 1 ? "" : "s");
+    
+    for (int i = 0; i < journey->numLegs; i++) {
+        const JourneyLeg* leg = &journey->legs[i];
+        formatClockTime(leg->departureTime, departure, sizeof(departure));
+        formatClockTime(leg->arrivalTime, arrival, sizeof(arrival));
+        printf("%d. %s %s -> %s %s (%s)\n", i + 1, departure,
+               timetable->graph->cities[leg->from].name, arrival,
+               timetable->graph->cities[leg->to].name, leg->mode);
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * Timetable Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+
+#include "graph.h"
+
+#define MINUTES_PER_DAY 1440
+#define TIMETABLE_DEFAULT_TRANSFER 10   // minutes to change vehicles at a city
+
+// One vehicle hop between consecutive stops. Times are minutes after
+// midnight of the first service day and may run past MINUTES_PER_DAY.
+typedef struct {
+    int departureTime;
+    int arrivalTime;
+    int from;                 // city index in the timetable's graph
+    int to;
+    int trip;                 // vehicle run; staying on board needs no transfer
+    unsigned char modeId;     // index into modeNames
+} Connection;
+
+// Every connection of a network, sorted by departure time so queries are a
+// single forward (or backward) sweep over one contiguous array
+typedef struct {
+    Graph* graph;             // supplies city ids and names; not owned
+    Connection* connections;
+    int numConnections;
+    int capacity;
+    int numTrips;             // trip ids are 0 .. numTrips - 1
+    int transferMinutes;      // minimum change time between trips
+    bool sorted;              // false after addConnection until the next query
+    int numModes;
+    char modeNames[MAX_MODES][MAX_MODE_LENGTH];
+} Timetable;
+
+// One ride on one trip, possibly over several connections
+typedef struct {
+    int from;
+    int to;
+    int departureTime;
+    int arrivalTime;
+    int trip;
+    char mode[MAX_MODE_LENGTH];
+} JourneyLeg;
+
+typedef struct {
+    int departureTime;
+    int arrivalTime;
+    int numLegs;
+    JourneyLeg* legs;
+} Journey;
+
+// Departure/arrival pairs where leaving later always means arriving later
+typedef struct {
+    int departureTime;
+    int arrivalTime;
+} ProfileEntry;
+
+typedef struct {
+    int numEntries;
+    ProfileEntry* entries;    // ascending departure time
+} Profile;
+
+// Building
+Timetable* createTimetable(Graph* graph);
+void destroyTimetable(Timetable* timetable);
+int addConnection(Timetable* timetable, const char* fromId, const char* toId, int departureTime,
+                  int arrivalTime, int trip, const char* mode);
+Timetable* buildTimetableFromRoutes(Graph* graph, int firstDeparture, int lastDeparture);
+
+// Connection Scan queries
+Journey* earliestArrival(Timetable* timetable, int source, int target, int departAfter);
+Profile* profileQuery(Timetable* timetable, int source, int target, int windowStart, int windowEnd);
+void destroyJourney(Journey* journey);
+void destroyProfile(Profile* profile);
+
+// Clock helpers
+int parseClockTime(const char* text);
+void formatClockTime(int minutes, char* buffer, size_t size);
+void printJourney(const Timetable* timetable, const Journey* journey);
+
+#endif // TIMETABLE_H
@@ -0,0 +1,113 @@
+/**
+ * Buffered Output Writer Implementation
+ * Travel Route Planner - C Implementation
+ */
+
+#include "writer.h"
+
+/**
+ * Attach a writer to an open stream
+ */
+bool initWriter(BufferedWriter* writer, FILE* stream, size_t capacity) {
+    writer->stream = stream;
+    writer->used = 0;
+    writer->capacity = capacity > 64 ? capacity : 64;
+    writer->failed = false;
+    writer->buffer = (char*)malloc(writer->capacity);
+    if (!writer->buffer) {
+        fprintf(stderr, "Error: Memory allocation failed for output buffer\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Hand everything buffered so far to the stream
+ */
+bool flushWriter(BufferedWriter* writer) {
+    if (writer->used > 0 &&
+        fwrite(writer->buffer, 1, writer->used, writer->stream) != writer->used) {
+        writer->failed = true;
+    }
+    writer->used = 0;
+    return !writer->failed;
+}
+
+/**
+ * Flush and release the buffer (the stream stays open)
+ */
+bool closeWriter(BufferedWriter* writer) {
+    bool ok = flushWriter(writer) && fflush(writer->stream) == 0;
+    free(writer->buffer);
+    writer->buffer = NULL;
+    return ok;
+}
+
+void writeBytes(BufferedWriter* writer, const char* data, size_t length) {
+    if (length > writer->capacity - writer->used) {
+        flushWriter(writer);
+        if (length > writer->capacity) {
+            if (fwrite(data, 1, length, writer->stream) != length) writer->failed = true;
+            return;
+        }
+    }
+    memcpy(writer->buffer + writer->used, data, length);
+    writer->used += length;
+}
+
+void writeString(BufferedWriter* writer, const char* text) {
+    writeBytes(writer, text, strlen(text));
+}
+
+/**
+ * Decimal integer without printf
+ */
+void writeInt(BufferedWriter* writer, long value) {
+    char digits[24];
+    int i = sizeof(digits);
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    
+    do {
+        digits[--i] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[--i] = '-';
+    
+    writeBytes(writer, digits + i, sizeof(digits) - i);
+}
+
+/**
+ * Number rounded to two decimals, e.g. 20.5 -> "20.50" (same as %.2f)
+ */
+void writeFixed2(BufferedWriter* writer, double value) {
+    if (value < 0) {
+        writeChar(writer, '-');
+        value = -value;
+    }
+    long hundredths = lround(value * 100);
+    writeInt(writer, hundredths / 100);
+    writeChar(writer, '.');
+    writeChar(writer, (char)('0' + hundredths / 10 % 10));
+    writeChar(writer, (char)('0' + hundredths % 10));
+}
+
+/**
+ * Quoted JSON string with the required escapes
+ */
+void writeJsonString(BufferedWriter* writer, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    writeChar(writer, '"');
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            writeChar(writer, '\\');
+            writeChar(writer, (char)*p);
+        } else if (*p < 0x20) {
+            writeString(writer, "\\u00");
+            writeChar(writer, hex[*p >> 4]);
+            writeChar(writer, hex[*p & 15]);
+        } else {
+            writeChar(writer, (char)*p);
+        }
+    }
+    writeChar(writer, '"');
+}
@@ -0,0 +1,37 @@
+/**
+ * Buffered Output Writer Header File
+ * Travel Route Planner - C Implementation
+ */
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include "graph.h"
+
+#define WRITER_BUFFER_SIZE (1 << 20)
+
+// Appends formatted output to a large in-memory buffer and hands it to the
+// stream in one fwrite when full, avoiding per-field printf overhead.
+typedef struct {
+    FILE* stream;
+    char* buffer;
+    size_t used;
+    size_t capacity;
+    bool failed;              // a write to the stream failed
+} BufferedWriter;
+
+bool initWriter(BufferedWriter* writer, FILE* stream, size_t capacity);
+bool flushWriter(BufferedWriter* writer);
+bool closeWriter(BufferedWriter* writer);
+void writeBytes(BufferedWriter* writer, const char* data, size_t length);
+void writeString(BufferedWriter* writer, const char* text);
+void writeInt(BufferedWriter* writer, long value);
+void writeFixed2(BufferedWriter* writer, double value);
+void writeJsonString(BufferedWriter* writer, const char* text);
+
+static inline void writeChar(BufferedWriter* writer, char c) {
+    if (writer->used == writer->capacity) flushWriter(writer);
+    writer->buffer[writer->used++] = c;
+}
+
+#endif // WRITER_H